@@ -1,6 +1,7 @@
 #include <stdio.h>
 #include "pico/stdlib.h"
 #include "ili9341.h"
+#include "ili9341_widget.h"
 
 int main() {
     stdio_init_all();
@@ -50,10 +51,18 @@ int main() {
     ili9341_fill_screen(BLACK);
     ili9341_draw_string(30, 50, "Counter Demo:", WHITE, BLACK, 2);
     
-    char buffer[20];
+    // The readout redraws only the digits that change, e.g. one cell
+    // from 41 to 42
+    ili9341_ui_t ui;
+    ili9341_readout_t count;
+    ili9341_ui_init(&ui);
+    ili9341_readout_init(&count, 50 + 7 * 18, 100, 3, 3, GREEN, BLACK);
+    ili9341_ui_add(&ui, &count.base);
+    
+    ili9341_draw_string(50, 100, "Count:", GREEN, BLACK, 3);
     for (int i = 0; i <= 100; i++) {
-        sprintf(buffer, "Count: %d  ", i);
-        ili9341_draw_string(50, 100, buffer, GREEN, BLACK, 3);
+        ili9341_readout_set_value(&count, i);
+        ili9341_ui_commit(&ui);
         sleep_ms(50);
     }
     
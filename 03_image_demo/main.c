@@ -1,7 +1,7 @@
 #include <stdio.h>
-#include <math.h>
 #include "pico/stdlib.h"
 #include "ili9341.h"
+#include "ili9341_math.h"
 
 // Function to generate a smiley face procedurally
 void draw_smiley(uint16_t x, uint16_t y, uint16_t size) {
@@ -17,9 +17,8 @@ void draw_smiley(uint16_t x, uint16_t y, uint16_t size) {
     
     // Smile (draw using small circles to approximate arc)
     for (int angle = 20; angle < 160; angle += 5) {
-        float rad = angle * 3.14159 / 180.0;
-        int sx = x + (size/2) * cos(rad);
-        int sy = y + (size/2) * sin(rad);
+        int32_t sx, sy;
+        ili9341_polar(x, y, size/2, ILI9341_DEG(angle), &sx, &sy);
         ili9341_fill_circle(sx, sy, 2, BLACK);
     }
 }
@@ -69,28 +68,21 @@ void draw_checkerboard(uint16_t x, uint16_t y, uint16_t size, uint16_t squares)
     }
 }
 
+// Pixel art heart as a 7x7 1-bpp mask, one byte per row
+static const uint8_t heart_mask[7] = {
+    0x6C,   // .##.##.
+    0xFE,   // #######
+    0xFE,   // #######
+    0xFE,   // #######
+    0x7C,   // .#####.
+    0x38,   // ..###..
+    0x10    // ...#...
+};
+
 // Function to draw a simple pixel art heart
 void draw_heart(uint16_t cx, uint16_t cy, uint16_t size) {
-    // Heart shape using pixels
-    uint8_t heart_pattern[7][7] = {
-        {0,1,1,0,1,1,0},
-        {1,1,1,1,1,1,1},
-        {1,1,1,1,1,1,1},
-        {1,1,1,1,1,1,1},
-        {0,1,1,1,1,1,0},
-        {0,0,1,1,1,0,0},
-        {0,0,0,1,0,0,0}
-    };
-    
-    for (int i = 0; i < 7; i++) {
-        for (int j = 0; j < 7; j++) {
-            if (heart_pattern[j][i]) {
-                ili9341_fill_rect(cx + i * size - 3 * size, 
-                                cy + j * size - 3 * size, 
-                                size, size, RED);
-            }
-        }
-    }
+    // Transparent (bg == color), scaled by size
+    ili9341_draw_bitmap_mask(cx - 3 * size, cy - 3 * size, 7, 7, heart_mask, RED, RED, size);
 }
 
 int main() {
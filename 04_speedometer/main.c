@@ -1,8 +1,29 @@
 #include <stdio.h>
 #include "pico/stdlib.h"
 #include "ili9341.h"
+#include "ili9341_fb.h"
+#include "ili9341_server.h"
 #include "speedometer.h"
 
+// Render into RAM and push only what changed each frame (150 KB of SRAM).
+// Set to 0 to draw straight to the panel.
+#define USE_FRAMEBUFFER 1
+
+#if USE_FRAMEBUFFER
+static uint16_t framebuffer[ILI9341_WIDTH * ILI9341_HEIGHT];
+#define FRAME_DONE() ili9341_flush()
+#else
+#define FRAME_DONE() ((void)0)
+#endif
+
+// Let core1 drive the SPI bus: frames are queued and sent while core0
+// computes the next one. Set to 0 to keep everything on core0.
+#define USE_DISPLAY_SERVER 1
+
+#if USE_DISPLAY_SERVER
+static ili9341_server_t display_server;
+#endif
+
 int main() {
     stdio_init_all();
     sleep_ms(2000);
@@ -18,11 +39,22 @@ int main() {
         .baudrate = 40000000
     };
     
+#if USE_DISPLAY_SERVER
+    ili9341_server_init(&display_server, &ili9341_pico_transport, &display_config);
+    display_config.transport = &ili9341_server_transport;
+    display_config.transport_ctx = &display_server;
+#endif
+    
     ili9341_init(&display_config);
     printf("Modern speedometer initialized\n");
     
+#if USE_FRAMEBUFFER
+    ili9341_fb_begin(framebuffer, sizeof(framebuffer) / sizeof(framebuffer[0]));
+#endif
+    
     // Draw the modern gauge background
     draw_modern_gauge_background();
+    FRAME_DONE();
     printf("Modern gauge background drawn\n");
     
     int current_speed = 0;
@@ -32,6 +64,7 @@ int main() {
     while (1) {
         // Start from neutral
         update_modern_speed(0, 0, 0, 1);
+        FRAME_DONE();
         sleep_ms(2000);
         
         // Demo: Realistic acceleration with gear changes
@@ -41,6 +74,7 @@ int main() {
             current_rpm = calculate_rpm(speed, current_gear);
             
             update_modern_speed(current_speed, speed, current_gear, current_rpm);
+            FRAME_DONE();
             current_speed = speed;
             
             // Slight pause during gear changes for realism
@@ -60,6 +94,7 @@ int main() {
             current_rpm = calculate_rpm(speed, current_gear);
             
             update_modern_speed(current_speed, speed, current_gear, current_rpm);
+            FRAME_DONE();
             current_speed = speed;
             sleep_ms(30);
         }
@@ -76,6 +111,7 @@ int main() {
             if (current_rpm < 11) current_rpm = 11;
             
             update_modern_speed(current_speed, speed, current_gear, current_rpm);
+            FRAME_DONE();
             current_speed = speed;
             sleep_ms(25);
         }
@@ -89,12 +125,14 @@ int main() {
             current_rpm = calculate_rpm(speed, current_gear);
             
             update_modern_speed(current_speed, speed, current_gear, current_rpm);
+            FRAME_DONE();
             current_speed = speed;
             sleep_ms(30);
         }
         
         // Final neutral state
         update_modern_speed(0, 0, 0, 1);
+        FRAME_DONE();
         sleep_ms(3000);
     }
     
@@ -1,9 +1,13 @@
 #include "speedometer.h"
 #include "ili9341.h"
+#include "ili9341_math.h"
+#include "ili9341_widget.h"
 #include <stdio.h>
-#include <math.h>
 
-#define PI 3.14159265359
+// The gauge sweeps 270 degrees clockwise, starting 45 degrees below
+// 3 o'clock
+#define GAUGE_START ILI9341_DEG(45)
+#define GAUGE_SWEEP ILI9341_DEG(270)
 
 // Speed zones with colors - GREEN, YELLOW, ORANGE, RED
 SpeedZone speed_zones[] = {
@@ -13,38 +17,76 @@ SpeedZone speed_zones[] = {
     {200, NEON_RED}        // 160-200: Red
 };
 
+// Rings covered by a thick arc: radius - thickness/2 up to thickness pixels out
+#define ARC_OUTER(radius, thickness) ((radius) - (thickness) / 2 + (thickness) - 1)
+#define ARC_INNER(radius, thickness) ((radius) - (thickness) / 2 - 1)
+
 // Draw a thick arc segment
-void draw_arc_segment(int cx, int cy, int radius, float start_angle, float end_angle, uint16_t color, int thickness) {
-    for (float angle = start_angle; angle <= end_angle; angle += 0.5) {
-        float rad = (angle - 90) * PI / 180.0;
-        
-        for (int t = 0; t < thickness; t++) {
-            int r = radius - thickness/2 + t;
-            int x = cx + (int)(r * cos(rad));
-            int y = cy + (int)(r * sin(rad));
-            ili9341_draw_pixel(x, y, color);
-        }
-    }
+void draw_arc_segment(int cx, int cy, int radius, int32_t start_angle, int32_t end_angle, uint16_t color, int thickness) {
+    ili9341_fill_sector(cx, cy, ARC_OUTER(radius, thickness), ARC_INNER(radius, thickness),
+                        start_angle, end_angle, color);
+}
+
+static void segment_angles(int i, int segments, int32_t *seg_start, int32_t *seg_end) {
+    int32_t gap_angle = ILI9341_DEG(2);  // Gap between segments
+    
+    *seg_start = GAUGE_START + i * GAUGE_SWEEP / segments;
+    *seg_end = GAUGE_START + (i + 1) * GAUGE_SWEEP / segments - gap_angle;
 }
 
 // Draw segmented arc (like modern bike displays)
 void draw_segmented_arc(int cx, int cy, int radius, int segments, int thickness, int active_segments, uint16_t active_color, uint16_t inactive_color) {
-    float start_angle = 135.0;  // Start from bottom left
-    float end_angle = 45.0;     // End at bottom right (270 degree sweep)
-    float total_sweep = 270.0;
-    
-    float segment_angle = total_sweep / segments;
-    float gap_angle = 2.0;  // Gap between segments
-    
     for (int i = 0; i < segments; i++) {
-        float seg_start = start_angle + i * segment_angle;
-        float seg_end = seg_start + segment_angle - gap_angle;
+        int32_t seg_start, seg_end;
+        segment_angles(i, segments, &seg_start, &seg_end);
         
         uint16_t color = (i < active_segments) ? active_color : inactive_color;
         draw_arc_segment(cx, cy, radius, seg_start, seg_end, color, thickness);
     }
 }
 
+// Live parts of the gauge, redrawn by ili9341_ui_commit() only when their
+// values change
+#define ARC_SEGMENTS 40
+#define ARC_INACTIVE RGB565(30, 30, 40)
+
+static ili9341_ui_t gauge_ui;
+static ili9341_arc_t speed_arc;
+static ili9341_span_t speed_arc_spans[512];     // The 40 segments need about 400
+static ili9341_readout_t speed_readout;
+static ili9341_label_t gear_label;
+static ili9341_readout_t rpm_readout;
+static ili9341_indicator_t neutral_indicator;
+static bool gauge_ui_ready = false;
+
+static void init_gauge_widgets(void) {
+    if (gauge_ui_ready) return;
+    
+    ili9341_ui_init(&gauge_ui);
+    
+    ili9341_arc_init(&speed_arc, CENTER_X, CENTER_Y, ARC_OUTER(ARC_RADIUS, ARC_THICKNESS),
+                     ARC_INNER(ARC_RADIUS, ARC_THICKNESS), GAUGE_START, GAUGE_SWEEP, ILI9341_DEG(2),
+                     ARC_SEGMENTS, NEON_GREEN, ARC_INACTIVE,
+                     speed_arc_spans, sizeof(speed_arc_spans) / sizeof(speed_arc_spans[0]));
+    ili9341_ui_add(&gauge_ui, &speed_arc.base);
+    
+    // Large centered speed number, three size-3 cells
+    ili9341_readout_init(&speed_readout, CENTER_X - 25, CENTER_Y - 15, 3, 3, NEON_GREEN, PANEL_BG);
+    ili9341_ui_add(&gauge_ui, &speed_readout.base);
+    
+    ili9341_label_init(&gear_label, CENTER_X - 8, 195, 3, NEON_GREEN, PANEL_BG, "N");
+    ili9341_ui_add(&gauge_ui, &gear_label.base);
+    
+    ili9341_readout_init(&rpm_readout, 50, 220, 2, 2, NEON_GREEN, DARK_BG);
+    ili9341_ui_add(&gauge_ui, &rpm_readout.base);
+    
+    // Neutral indicator position (right side)
+    ili9341_indicator_init(&neutral_indicator, 285, 15, 2, "N", NEON_GREEN, DARKGREY, PANEL_BG);
+    ili9341_ui_add(&gauge_ui, &neutral_indicator.base);
+    
+    gauge_ui_ready = true;
+}
+
 // Get color based on speed zone
 uint16_t get_speed_color(int speed) {
     for (int i = 0; i < sizeof(speed_zones)/sizeof(SpeedZone); i++) {
@@ -74,21 +116,13 @@ void draw_modern_gauge_background(void) {
     ili9341_draw_string(250, 12, "FUEL", DARKGREY, PANEL_BG, 1);
     ili9341_draw_string(260, 22, "[ ]", WHITE, PANEL_BG, 1);
     
-    // Neutral indicator position (right side)
-    ili9341_draw_string(285, 15, "N", DARKGREY, PANEL_BG, 2);
-    
-    // Draw background arc segments (inactive)
-    draw_segmented_arc(CENTER_X, CENTER_Y, ARC_RADIUS, 40, ARC_THICKNESS, 0, NEON_BLUE, RGB565(30, 30, 40));
-    
     // Draw speed tick marks (minimal, modern style)
     for (int speed = 0; speed <= MAX_SPEED; speed += 20) {
-        float angle = 135 + (speed * 270.0 / MAX_SPEED);
-        float rad = (angle - 90) * PI / 180.0;
+        int32_t angle = GAUGE_START + speed * GAUGE_SWEEP / MAX_SPEED;
+        int32_t x1, y1, x2, y2;
         
-        int x1 = CENTER_X + (int)((ARC_RADIUS - ARC_THICKNESS - 5) * cos(rad));
-        int y1 = CENTER_Y + (int)((ARC_RADIUS - ARC_THICKNESS - 5) * sin(rad));
-        int x2 = CENTER_X + (int)((ARC_RADIUS - ARC_THICKNESS - 12) * cos(rad));
-        int y2 = CENTER_Y + (int)((ARC_RADIUS - ARC_THICKNESS - 12) * sin(rad));
+        ili9341_polar(CENTER_X, CENTER_Y, ARC_RADIUS - ARC_THICKNESS - 5, angle, &x1, &y1);
+        ili9341_polar(CENTER_X, CENTER_Y, ARC_RADIUS - ARC_THICKNESS - 12, angle, &x2, &y2);
         
         ili9341_draw_line(x1, y1, x2, y2, DARKGREY);
     }
@@ -112,67 +146,52 @@ void draw_modern_gauge_background(void) {
     // Temperature indicator (bottom right)
     ili9341_draw_string(260, 215, "TEMP", DARKGREY, DARK_BG, 1);
     ili9341_draw_string(265, 225, "---C", DARKGREY, DARK_BG, 1);
+    
+    // The screen behind the widgets is new: draw them in full
+    init_gauge_widgets();
+    ili9341_ui_invalidate(&gauge_ui);
+    ili9341_ui_commit(&gauge_ui);
 }
 
 // Update the speed display with modern animation
 void update_modern_speed(int old_speed, int new_speed, int gear, int rpm) {
-    // Calculate active segments
-    int total_segments = 40;
-    int old_segments = (old_speed * total_segments) / MAX_SPEED;
-    int new_segments = (new_speed * total_segments) / MAX_SPEED;
-    
-    // Get appropriate color for current speed
-    uint16_t speed_color = get_speed_color(new_speed);
-    
-    // Update arc segments
-    if (new_segments != old_segments) {
-        draw_segmented_arc(CENTER_X, CENTER_Y, ARC_RADIUS, total_segments, ARC_THICKNESS, 
-                          new_segments, speed_color, RGB565(30, 30, 40));
-    }
-    
-    // Update digital speed display
-    char speed_str[10];
-    sprintf(speed_str, "%3d", new_speed);
+    // Widgets remember what they show, so old_speed is not needed: each
+    // part is redrawn only if its value or color changed
+    (void)old_speed;
+    init_gauge_widgets();
     
-    // Clear old speed with background
-    ili9341_fill_rect(CENTER_X - 45, CENTER_Y - 20, 90, 30, PANEL_BG);
+    // Arc segments, in the speed zone color
+    ili9341_arc_set_active(&speed_arc, (new_speed * ARC_SEGMENTS) / MAX_SPEED);
+    ili9341_arc_set_color(&speed_arc, get_speed_color(new_speed));
     
-    // Draw new speed in large font with appropriate color
+    // Digital speed display
     uint16_t display_color = (new_speed > 160) ? NEON_RED : 
                             (new_speed > 120) ? NEON_ORANGE : 
                             (new_speed > 60) ? NEON_YELLOW : NEON_GREEN;
+    ili9341_readout_set_value(&speed_readout, new_speed);
+    ili9341_readout_set_color(&speed_readout, display_color);
     
-    // Large centered speed number
-    int text_width = (new_speed >= 100) ? 45 : (new_speed >= 10) ? 30 : 15;
-    ili9341_draw_string(CENTER_X - text_width/2, CENTER_Y - 15, speed_str, display_color, PANEL_BG, 3);
-    
-    // Update gear indicator (moved up to 180 region)
+    // Gear indicator
     char gear_str[5];
     if (gear == 0) {
         sprintf(gear_str, "N");
-        ili9341_fill_rect(CENTER_X - 23, 193, 46, 20, PANEL_BG);
-        ili9341_draw_string(CENTER_X - 8, 195, gear_str, NEON_GREEN, PANEL_BG, 3);
+        ili9341_label_set_color(&gear_label, NEON_GREEN);
     } else {
         sprintf(gear_str, "%d", gear);
-        ili9341_fill_rect(CENTER_X - 23, 193, 46, 20, PANEL_BG);
-        ili9341_draw_string(CENTER_X - 8, 195, gear_str, display_color, PANEL_BG, 3);
+        ili9341_label_set_color(&gear_label, display_color);
     }
+    ili9341_label_set_text(&gear_label, gear_str);
     
-    // Update RPM display (simplified)
-    char rpm_str[10];
-    sprintf(rpm_str, "%2d", rpm);
-    ili9341_fill_rect(50, 215, 30, 20, DARK_BG);
-    
+    // RPM display
     uint16_t rpm_color = (rpm > 10) ? NEON_RED : 
                         (rpm > 7) ? NEON_ORANGE : NEON_GREEN;
-    ili9341_draw_string(50, 220, rpm_str, rpm_color, DARK_BG, 2);
+    ili9341_readout_set_value(&rpm_readout, rpm);
+    ili9341_readout_set_color(&rpm_readout, rpm_color);
     
-    // Update neutral indicator
-    if (gear == 0) {
-        ili9341_draw_string(285, 15, "N", NEON_GREEN, PANEL_BG, 2);
-    } else {
-        ili9341_draw_string(285, 15, "N", DARKGREY, PANEL_BG, 2);
-    }
+    // Neutral indicator
+    ili9341_indicator_set(&neutral_indicator, gear == 0);
+    
+    ili9341_ui_commit(&gauge_ui);
 }
 
 // Calculate gear based on speed (realistic motorcycle gearing)
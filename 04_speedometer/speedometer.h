@@ -34,7 +34,8 @@ typedef struct {
 } SpeedZone;
 
 // Function prototypes
-void draw_arc_segment(int cx, int cy, int radius, float start_angle, float end_angle, 
+// Angles in ili9341_math.h units (1/65536 turn, clockwise from 3 o'clock)
+void draw_arc_segment(int cx, int cy, int radius, int32_t start_angle, int32_t end_angle, 
                       uint16_t color, int thickness);
 
 void draw_segmented_arc(int cx, int cy, int radius, int segments, int thickness, 
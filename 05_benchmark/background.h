@@ -0,0 +1,198 @@
+// Auto-generated from a procedural 320x240 dashboard background
+// Image size: 320x240 pixels
+// Data size: 2813 bytes
+// Compressed, draw with ili9341_draw_image()
+
+#ifndef BACKGROUND_H
+#define BACKGROUND_H
+
+#include <stdint.h>
+#include "ili9341_image.h"
+
+#define BACKGROUND_WIDTH 320
+#define BACKGROUND_HEIGHT 240
+
+const uint8_t background_data[2813] = {
+    0xAA, 0x4D, 0xEE, 0x7A, 0xFF, 0x00, 0x7A, 0xFF, 0x00, 0x7A, 0xFF, 0x00, 0x7A, 0xFF, 0x00, 0x7A, 
+    0xCE, 0x3B, 0xEE, 0x3E, 0xFF, 0x00, 0x01, 0xFF, 0x00, 0x04, 0xFF, 0x00, 0x07, 0xFF, 0x00, 0x0A, 
+    0xCE, 0xA0, 0x39, 0xEE, 0x7A, 0xFF, 0x00, 0x7A, 0xFF, 0x00, 0x7A, 0xFF, 0x00, 0x7A, 0xFF, 0x00, 
+    0x7A, 0xCE, 0x02, 0xEE, 0x05, 0xFF, 0x00, 0x08, 0xFF, 0x00, 0x0B, 0xFF, 0x00, 0x0E, 0xFF, 0x00, 
+    0x11, 0xCE, 0xA1, 0x39, 0xEE, 0x7A, 0xFF, 0x00, 0x7A, 0xFF, 0x00, 0x7A, 0xFF, 0x00, 0x7A, 0xFF, 
+    0x00, 0x7A, 0xCE, 0x0E, 0xEE, 0x11, 0xFF, 0x00, 0x14, 0xFF, 0x00, 0x17, 0xFF, 0x00, 0x1A, 0xFF, 
+    0x00, 0x1D, 0xCE, 0xA0, 0x39, 0xEE, 0x7A, 0xFF, 0x00, 0x7A, 0xFF, 0x00, 0x7A, 0xFF, 0x00, 0x7A, 
+    0xFF, 0x00, 0x7A, 0xCE, 0x15, 0xEE, 0x18, 0xFF, 0x00, 0x1B, 0xFF, 0x00, 0x1E, 0xFF, 0x00, 0x21, 
+    0xFF, 0x00, 0x24, 0xCE, 0xA1, 0x39, 0xEE, 0x7A, 0xFF, 0x00, 0x7A, 0xFF, 0x00, 0x7A, 0xFF, 0x00, 
+    0x7A, 0xFF, 0x00, 0x7A, 0xCE, 0x21, 0xEE, 0x24, 0xFF, 0x00, 0x27, 0xFF, 0x00, 0x2A, 0xFF, 0x00, 
+    0x2D, 0xFF, 0x00, 0x30, 0xCE, 0xA0, 0x39, 0xEE, 0x7A, 0xFF, 0x00, 0x7A, 0xFF, 0x00, 0x7A, 0xFF, 
+    0x00, 0x7A, 0xFF, 0x00, 0x7A, 0xCE, 0x28, 0xEE, 0x2B, 0xFF, 0x00, 0x2E, 0xFF, 0x00, 0x31, 0xFF, 
+    0x00, 0x34, 0xFF, 0x00, 0x37, 0xCE, 0xA1, 0x39, 0xEE, 0x7A, 0xFF, 0x00, 0x7A, 0xFF, 0x00, 0x7A, 
+    0xFF, 0x00, 0x7A, 0xFF, 0x00, 0x7A, 0xCE, 0x34, 0xEE, 0x37, 0xFF, 0x00, 0x3A, 0xFF, 0x00, 0x3D, 
+    0xFF, 0x00, 0x00, 0xFF, 0x00, 0x03, 0xCE, 0xA0, 0x39, 0xEE, 0x7A, 0xFF, 0x00, 0x7A, 0xFF, 0x00, 
+    0x7A, 0xFF, 0x00, 0x7A, 0xFF, 0x00, 0x7A, 0xCE, 0x3B, 0xEE, 0x3E, 0xFF, 0x00, 0x01, 0xFF, 0x00, 
+    0x04, 0xFF, 0x00, 0x07, 0xFF, 0x00, 0x0A, 0xCE, 0xA1, 0x39, 0xEE, 0x7A, 0xFF, 0x00, 0x7A, 0xFF, 
+    0x00, 0x7A, 0xFF, 0x00, 0x7A, 0xFF, 0x00, 0x7A, 0xCE, 0x07, 0xEE, 0x0A, 0xFF, 0x00, 0x0D, 0xFF, 
+    0x00, 0x10, 0xFF, 0x00, 0x13, 0xFF, 0x00, 0x16, 0xCE, 0xA0, 0x39, 0xEE, 0x7A, 0xFF, 0x00, 0x7A, 
+    0xFF, 0x00, 0x7A, 0xFF, 0x00, 0x7A, 0xFF, 0x00, 0x7A, 0xCE, 0x0E, 0xEE, 0x11, 0xFF, 0x00, 0x14, 
+    0xFF, 0x00, 0x17, 0xFF, 0x00, 0x1A, 0xFF, 0x00, 0x1D, 0xCE, 0xA1, 0x39, 0xEE, 0x7A, 0xFF, 0x00, 
+    0x7A, 0xFF, 0x00, 0x7A, 0xFF, 0x00, 0x7A, 0xFF, 0x00, 0x7A, 0xCE, 0x1A, 0xEE, 0x1D, 0xFF, 0x00, 
+    0x20, 0xFF, 0x00, 0x23, 0xFF, 0x00, 0x26, 0xFF, 0x00, 0x29, 0xCE, 0xA0, 0x39, 0xEE, 0x7A, 0xFF, 
+    0x00, 0x7A, 0xFF, 0x00, 0x7A, 0xFF, 0x00, 0x7A, 0xFF, 0x00, 0x7A, 0xCE, 0x21, 0xEE, 0x24, 0xFF, 
+    0x00, 0x27, 0xFF, 0x00, 0x2A, 0xFF, 0x00, 0x2D, 0xFF, 0x00, 0x30, 0xCE, 0xA1, 0x39, 0xEE, 0x7A, 
+    0xFF, 0x00, 0x7A, 0xFF, 0x00, 0x7A, 0xFF, 0x00, 0x7A, 0xFF, 0x00, 0x7A, 0xCE, 0x2D, 0xEE, 0x30, 
+    0xFF, 0x00, 0x33, 0xFF, 0x00, 0x36, 0xFF, 0x00, 0x39, 0xFF, 0x00, 0x3C, 0xCE, 0xA0, 0x39, 0xEE, 
+    0x7A, 0xFF, 0x00, 0x7A, 0xFF, 0x00, 0x7A, 0xFF, 0x00, 0x7A, 0xFF, 0x00, 0x7A, 0xCE, 0x34, 0xEE, 
+    0x37, 0xFF, 0x00, 0x3A, 0xFF, 0x00, 0x3D, 0xFF, 0x00, 0x00, 0xFF, 0x00, 0x03, 0xCE, 0xA1, 0x39, 
+    0xEE, 0x7A, 0xFF, 0x00, 0x7A, 0xFF, 0x00, 0x7A, 0xFF, 0x00, 0x7A, 0xFF, 0x00, 0x7A, 0xCE, 0x00, 
+    0xEE, 0x03, 0xFF, 0x00, 0x06, 0xFF, 0x00, 0x09, 0xFF, 0x00, 0x0C, 0xFF, 0x00, 0x0F, 0xCE, 0xA0, 
+    0x39, 0xEE, 0x7A, 0xFF, 0x00, 0x7A, 0xFF, 0x00, 0x7A, 0xFF, 0x00, 0x7A, 0xFF, 0x00, 0x7A, 0xCE, 
+    0x07, 0xEE, 0x0A, 0xFF, 0x00, 0x0D, 0xFF, 0x00, 0x10, 0xFF, 0x00, 0x13, 0xFF, 0x00, 0x16, 0xCE, 
+    0xFE, 0x10, 0x82, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xE2, 0xB5, 0x7B, 0xFF, 0x4C, 
+    0x28, 0xCE, 0x07, 0xFF, 0x4C, 0x28, 0xD6, 0x07, 0x91, 0x98, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 
+    0x2F, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 0x2F, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 0x2F, 0xFF, 
+    0x4A, 0x07, 0x28, 0xD6, 0x07, 0x2F, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 0x2F, 0xFF, 0x4A, 0x07, 
+    0x28, 0xD6, 0x07, 0x2F, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 0x2F, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 
+    0x07, 0x2F, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 0x2F, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 0x2F, 
+    0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 0x2F, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 0x2F, 0xFF, 0x4A, 
+    0x07, 0x28, 0xCE, 0x07, 0x2F, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 0x2F, 0xFF, 0x4A, 0x07, 0x28, 
+    0xCE, 0x07, 0x2F, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 0x2F, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 
+    0x2F, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 0x2F, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 0x2F, 0xFF, 
+    0x4A, 0x07, 0x28, 0xD6, 0x07, 0x2F, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 0x2F, 0xFF, 0x4A, 0x07, 
+    0x28, 0xD6, 0x07, 0x2F, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 0x2F, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 
+    0x07, 0x2F, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 0x2F, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 0x2F, 
+    0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 0x2F, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 0x2F, 0xFF, 0x4A, 
+    0x07, 0x28, 0xCE, 0x07, 0x2F, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 0x92, 0x97, 0xFF, 0x4A, 0x07, 
+    0x28, 0xCE, 0x07, 0x37, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 0x37, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 
+    0x07, 0x37, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 0x37, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 0x37, 
+    0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 0x37, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 0x37, 0xFF, 0x4A, 
+    0x07, 0x28, 0xD6, 0x07, 0x37, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 0x37, 0xFF, 0x4A, 0x07, 0x28, 
+    0xD6, 0x07, 0x37, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 0x37, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 
+    0x37, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 0x37, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 0x37, 0xFF, 
+    0x4A, 0x07, 0x28, 0xCE, 0x07, 0x37, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 0x37, 0xFF, 0x4A, 0x07, 
+    0x28, 0xCE, 0x07, 0x37, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 0x37, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 
+    0x07, 0x37, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 0x37, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 0x37, 
+    0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 0x37, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 0x37, 0xFF, 0x4A, 
+    0x07, 0x28, 0xD6, 0x07, 0x37, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 0x37, 0xFF, 0x4A, 0x07, 0x28, 
+    0xD6, 0x07, 0x37, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 0x37, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 
+    0x37, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 0x37, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 0x37, 0xFF, 
+    0x4A, 0x07, 0x28, 0xCE, 0x07, 0x37, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 0x37, 0xFF, 0x4A, 0x07, 
+    0x28, 0xCE, 0x07, 0x37, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 0x37, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 
+    0x07, 0x37, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 0x37, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 0x37, 
+    0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 0x37, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 0x37, 0xFF, 0x4A, 
+    0x07, 0x28, 0xD6, 0x07, 0x37, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 0x37, 0xFF, 0x4A, 0x07, 0x28, 
+    0xD6, 0x07, 0x37, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 0x37, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 
+    0x37, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 0x37, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 0x37, 0xFF, 
+    0x4A, 0x07, 0x28, 0xCE, 0x07, 0x37, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 0x37, 0xFF, 0x4A, 0x07, 
+    0x28, 0xCE, 0x07, 0x37, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 0x37, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 
+    0x07, 0x37, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 0x37, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 0x37, 
+    0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 0x37, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 0x37, 0xFF, 0x4A, 
+    0x07, 0x28, 0xD6, 0x07, 0x37, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 0x37, 0xFF, 0x4A, 0x07, 0x28, 
+    0xD6, 0x07, 0x37, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 0x37, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 
+    0x37, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 0x37, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 0x37, 0xFF, 
+    0x4A, 0x07, 0x28, 0xCE, 0x07, 0x37, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 0x93, 0x98, 0xFF, 0x4A, 
+    0x07, 0x28, 0xCE, 0x07, 0x03, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 0x03, 0xFF, 0x4A, 0x07, 0x28, 
+    0xCE, 0x07, 0x03, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 0x03, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 
+    0x03, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 0x03, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 0x03, 0xFF, 
+    0x4A, 0x07, 0x28, 0xD6, 0x07, 0x03, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 0x03, 0xFF, 0x4A, 0x07, 
+    0x28, 0xD6, 0x07, 0x03, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 0x03, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 
+    0x07, 0x03, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 0x03, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 0x03, 
+    0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 0x03, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 0x03, 0xFF, 0x4A, 
+    0x07, 0x28, 0xCE, 0x07, 0x03, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 0x03, 0xFF, 0x4A, 0x07, 0x28, 
+    0xCE, 0x07, 0x03, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 0x03, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 
+    0x03, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 0x03, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 0x03, 0xFF, 
+    0x4A, 0x07, 0x28, 0xD6, 0x07, 0x03, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 0x03, 0xFF, 0x4A, 0x07, 
+    0x28, 0xD6, 0x07, 0x03, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 0x03, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 
+    0x07, 0x03, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 0x03, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 0x03, 
+    0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 0x03, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 0x03, 0xFF, 0x4A, 
+    0x07, 0x28, 0xCE, 0x07, 0x03, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 0x03, 0xFF, 0x4A, 0x07, 0x28, 
+    0xCE, 0x07, 0x03, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 0x03, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 
+    0x03, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 0x03, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 0x03, 0xFF, 
+    0x4A, 0x07, 0x28, 0xD6, 0x07, 0x03, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 0x03, 0xFF, 0x4A, 0x07, 
+    0x28, 0xD6, 0x07, 0x03, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 0x03, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 
+    0x07, 0x03, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 0x03, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 0x03, 
+    0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 0x03, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 0x03, 0xFF, 0x4A, 
+    0x07, 0x28, 0xCE, 0x07, 0x03, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 0x03, 0xFF, 0x4A, 0x07, 0x28, 
+    0xCE, 0x07, 0x03, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 0x03, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 
+    0x03, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 0x03, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 0x03, 0xFF, 
+    0x4A, 0x07, 0x28, 0xD6, 0x07, 0x03, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 0x03, 0xFF, 0x4A, 0x07, 
+    0x28, 0xD6, 0x07, 0x03, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 0x03, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 
+    0x07, 0x03, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 0x03, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 0xFF, 
+    0x4C, 0x28, 0xCE, 0x07, 0xFF, 0x4C, 0x28, 0xD6, 0x07, 0xFF, 0x4C, 0x28, 0xFF, 0x74, 0x07, 0x94, 
+    0x97, 0xFF, 0x4A, 0x07, 0x28, 0xFF, 0x74, 0x07, 0x0B, 0xFF, 0x4A, 0x07, 0x28, 0xFF, 0x74, 0x07, 
+    0x0B, 0xFF, 0x4A, 0x07, 0x28, 0xFF, 0x74, 0x07, 0x0B, 0xFF, 0x4A, 0x07, 0x28, 0xFF, 0x74, 0x07, 
+    0x0B, 0xFF, 0x4A, 0x07, 0x28, 0xFF, 0x74, 0x07, 0x0B, 0xFF, 0x4A, 0x07, 0x28, 0xFF, 0x74, 0x07, 
+    0x0B, 0xFF, 0x4A, 0x07, 0x28, 0xFF, 0x74, 0x07, 0xFF, 0x4C, 0x28, 0xCE, 0x07, 0xFF, 0x4C, 0x28, 
+    0xD6, 0x07, 0x0B, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 0x0B, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 
+    0x0B, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 0x0B, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 0x0B, 0xFF, 
+    0x4A, 0x07, 0x28, 0xCE, 0x07, 0x0B, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 0x0B, 0xFF, 0x4A, 0x07, 
+    0x28, 0xCE, 0x07, 0x0B, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 0x0B, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 
+    0x07, 0x0B, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 0x0B, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 0x0B, 
+    0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 0x0B, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 0x0B, 0xFF, 0x4A, 
+    0x07, 0x28, 0xD6, 0x07, 0x94, 0x98, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 0x12, 0xFF, 0x4A, 0x07, 
+    0x28, 0xD6, 0x07, 0x12, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 0x12, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 
+    0x07, 0x12, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 0x12, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 0x12, 
+    0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 0x12, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 0x12, 0xFF, 0x4A, 
+    0x07, 0x28, 0xCE, 0x07, 0x12, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 0x12, 0xFF, 0x4A, 0x07, 0x28, 
+    0xCE, 0x07, 0x12, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 0x12, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 
+    0x12, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 0x12, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 0x12, 0xFF, 
+    0x4A, 0x07, 0x28, 0xD6, 0x07, 0x12, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 0x12, 0xFF, 0x4A, 0x07, 
+    0x28, 0xD6, 0x07, 0x12, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 0x12, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 
+    0x07, 0x12, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 0x12, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 0x12, 
+    0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 0x12, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 0x12, 0xFF, 0x4A, 
+    0x07, 0x28, 0xCE, 0x07, 0x12, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 0x12, 0xFF, 0x4A, 0x07, 0x28, 
+    0xCE, 0x07, 0x12, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 0x12, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 
+    0x12, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 0x12, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 0x12, 0xFF, 
+    0x4A, 0x07, 0x28, 0xD6, 0x07, 0x95, 0x98, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 0x17, 0xFF, 0x4A, 
+    0x07, 0x28, 0xD6, 0x07, 0x17, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 0x17, 0xFF, 0x4A, 0x07, 0x28, 
+    0xD6, 0x07, 0x17, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 0x17, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 
+    0x17, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 0x17, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 0x17, 0xFF, 
+    0x4A, 0x07, 0x28, 0xCE, 0x07, 0x17, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 0x17, 0xFF, 0x4A, 0x07, 
+    0x28, 0xCE, 0x07, 0x17, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 0x17, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 
+    0x07, 0x17, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 0x17, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 0x17, 
+    0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 0x17, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 0x17, 0xFF, 0x4A, 
+    0x07, 0x28, 0xD6, 0x07, 0x17, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 0x17, 0xFF, 0x4A, 0x07, 0x28, 
+    0xD6, 0x07, 0x17, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 0x17, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 
+    0x17, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 0x17, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 0x17, 0xFF, 
+    0x4A, 0x07, 0x28, 0xCE, 0x07, 0x17, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 0x17, 0xFF, 0x4A, 0x07, 
+    0x28, 0xCE, 0x07, 0x17, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 0x17, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 
+    0x07, 0x17, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 0x17, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 0x17, 
+    0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 0x17, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 0x17, 0xFF, 0x4A, 
+    0x07, 0x28, 0xD6, 0x07, 0x17, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 0x17, 0xFF, 0x4A, 0x07, 0x28, 
+    0xD6, 0x07, 0x17, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 0x17, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 
+    0x17, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 0x17, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 0x17, 0xFF, 
+    0x4A, 0x07, 0x28, 0xCE, 0x07, 0x17, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 0x17, 0xFF, 0x4A, 0x07, 
+    0x28, 0xCE, 0x07, 0x17, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 0x17, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 
+    0x07, 0x17, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 0x17, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 0x17, 
+    0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 0x17, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 0x17, 0xFF, 0x4A, 
+    0x07, 0x28, 0xD6, 0x07, 0x17, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 0x17, 0xFF, 0x4A, 0x07, 0x28, 
+    0xD6, 0x07, 0x17, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 0x17, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 
+    0x17, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 0x17, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 0x17, 0xFF, 
+    0x4A, 0x07, 0x28, 0xCE, 0x07, 0x17, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 0x17, 0xFF, 0x4A, 0x07, 
+    0x28, 0xCE, 0x07, 0x17, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 0x17, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 
+    0x07, 0x17, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 0x17, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 0x17, 
+    0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 0x96, 0x98, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 0x26, 0xFF, 
+    0x4A, 0x07, 0x28, 0xD6, 0x07, 0x26, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 0x26, 0xFF, 0x4A, 0x07, 
+    0x28, 0xD6, 0x07, 0x26, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 0x26, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 
+    0x07, 0x26, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 0x26, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 0x26, 
+    0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 0x26, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 0x26, 0xFF, 0x4A, 
+    0x07, 0x28, 0xCE, 0x07, 0x26, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 0x26, 0xFF, 0x4A, 0x07, 0x28, 
+    0xCE, 0x07, 0x26, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 0x26, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 
+    0x26, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 0x26, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 0x26, 0xFF, 
+    0x4A, 0x07, 0x28, 0xD6, 0x07, 0x26, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 0x26, 0xFF, 0x4A, 0x07, 
+    0x28, 0xD6, 0x07, 0x26, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 0x26, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 
+    0x07, 0x26, 0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 0x26, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 0x26, 
+    0xFF, 0x4A, 0x07, 0x28, 0xCE, 0x07, 0x26, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 0x26, 0xFF, 0x4A, 
+    0x07, 0x28, 0xCE, 0x07, 0x26, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 0x26, 0xFF, 0x4A, 0x07, 0x28, 
+    0xCE, 0x07, 0x26, 0xFF, 0x4A, 0x07, 0x28, 0xD6, 0x07, 0xFF, 0x4C, 0x28, 0xCE, 0x07, 0xFF, 0x4C, 
+    0x28, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xE2, 0xA2, 0x89, 0xFF, 0xFF, 0xFF, 0xFF, 
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xEE
+};
+
+const ili9341_image_t background = {
+    320, 240, sizeof(background_data), background_data
+};
+
+#endif // BACKGROUND_H
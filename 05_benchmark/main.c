@@ -0,0 +1,456 @@
+// Drawing throughput benchmark
+//
+// On the Pico this times real transfers. Built for the host (see
+// Readme.md) it times the rasterizers alone and also reports the bytes each
+// operation puts on the wire, from which the SPI-bound rate at the
+// configured baudrate follows.
+
+#ifdef ILI9341_HOST
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include <stdio.h>
+#include <math.h>
+#include <stdlib.h>
+#include "ili9341.h"
+#include "ili9341_console.h"
+#include "ili9341_dlist.h"
+#include "ili9341_image.h"
+#include "ili9341_math.h"
+#include "background.h"
+
+#ifdef ILI9341_HOST
+#include <time.h>
+#include "ili9341_host.h"
+
+static ili9341_host_t host;
+
+static uint64_t now_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+#else
+#include "pico/stdlib.h"
+#include "hardware/clocks.h"
+
+static uint64_t now_us(void) {
+    return time_us_64();
+}
+#endif
+
+#define BAUDRATE 40000000
+
+typedef struct {
+    const char *name;
+    const char *unit;
+    uint32_t calls;
+    uint32_t units;             // Units drawn per call
+    void (*run)(uint32_t i);
+} benchmark_t;
+
+// Cheap deterministic coordinates, the same on every platform
+static uint32_t g_seed = 1;
+
+static uint16_t random_below(uint16_t limit) {
+    g_seed = g_seed * 1103515245 + 12345;
+    return (g_seed >> 16) % limit;
+}
+
+static uint16_t bench_color(uint32_t i) {
+    return ili9341_color565(i * 7, i * 3, 255 - i);
+}
+
+// Lines
+
+static void bench_hline(uint32_t i) {
+    ili9341_draw_line(0, i % ILI9341_HEIGHT, ILI9341_WIDTH - 1, i % ILI9341_HEIGHT, bench_color(i));
+}
+
+static void bench_vline(uint32_t i) {
+    ili9341_draw_line(i % ILI9341_WIDTH, 0, i % ILI9341_WIDTH, ILI9341_HEIGHT - 1, bench_color(i));
+}
+
+static void bench_line(uint32_t i) {
+    ili9341_draw_line(random_below(ILI9341_WIDTH), random_below(ILI9341_HEIGHT),
+                      random_below(ILI9341_WIDTH), random_below(ILI9341_HEIGHT), bench_color(i));
+}
+
+static void bench_rect(uint32_t i) {
+    ili9341_draw_rect(random_below(ILI9341_WIDTH / 2), random_below(ILI9341_HEIGHT / 2),
+                      ILI9341_WIDTH / 4, ILI9341_HEIGHT / 4, bench_color(i));
+}
+
+// Filled circles around a quarter-screen clip rectangle, many of them
+// partly or wholly outside it
+static void bench_clipped_circle(uint32_t i) {
+    ili9341_clip_push(ILI9341_WIDTH / 4, ILI9341_HEIGHT / 4, ILI9341_WIDTH / 2, ILI9341_HEIGHT / 2);
+    ili9341_fill_circle((int16_t)random_below(ILI9341_WIDTH + 80) - 40,
+                        (int16_t)random_below(ILI9341_HEIGHT + 80) - 40, 40, bench_color(i));
+    ili9341_clip_pop();
+}
+
+// Text, 20 characters per call
+
+static const char bench_text[] = "Speed 123 km/h ABCDE";
+
+static void bench_text_opaque(uint32_t i) {
+    ili9341_draw_string(random_below(ILI9341_WIDTH / 2), random_below(ILI9341_HEIGHT - 16),
+                        bench_text, WHITE, bench_color(i), 2);
+}
+
+static void bench_text_transparent(uint32_t i) {
+    ili9341_draw_string(random_below(ILI9341_WIDTH / 2), random_below(ILI9341_HEIGHT - 16),
+                        bench_text, bench_color(i), bench_color(i), 2);
+}
+
+// Full-screen images, drawn as bands of one shared image
+
+#define BAND_HEIGHT 40
+
+static uint16_t g_band[ILI9341_WIDTH * BAND_HEIGHT];
+static uint8_t g_band_be[ILI9341_WIDTH * BAND_HEIGHT * 2];
+
+static void make_band(void) {
+    for (uint32_t i = 0; i < ILI9341_WIDTH * BAND_HEIGHT; i++) {
+        uint16_t color = ili9341_color565(i % ILI9341_WIDTH, i / ILI9341_WIDTH * 6, 128);
+        g_band[i] = color;
+        g_band_be[2 * i] = color >> 8;
+        g_band_be[2 * i + 1] = color & 0xFF;
+    }
+}
+
+static void bench_bitmap(uint32_t i) {
+    (void)i;
+    for (uint16_t y = 0; y < ILI9341_HEIGHT; y += BAND_HEIGHT) {
+        ili9341_draw_bitmap(0, y, ILI9341_WIDTH, BAND_HEIGHT, g_band);
+    }
+}
+
+static void bench_bitmap_be(uint32_t i) {
+    (void)i;
+    for (uint16_t y = 0; y < ILI9341_HEIGHT; y += BAND_HEIGHT) {
+        ili9341_draw_bitmap_be(0, y, ILI9341_WIDTH, BAND_HEIGHT, g_band_be);
+    }
+}
+
+static void bench_bitmap_be_async(uint32_t i) {
+    (void)i;
+    for (uint16_t y = 0; y < ILI9341_HEIGHT; y += BAND_HEIGHT) {
+        ili9341_draw_bitmap_be_async(0, y, ILI9341_WIDTH, BAND_HEIGHT, g_band_be, NULL, NULL);
+    }
+}
+
+// 4-bpp band, 20-pixel columns stepping through a 16-color ramp
+static uint8_t g_band_4bpp[ILI9341_WIDTH * BAND_HEIGHT / 2];
+static uint16_t g_ramp[16];
+
+static void make_band_4bpp(void) {
+    for (uint8_t i = 0; i < 16; i++) {
+        g_ramp[i] = ili9341_color565(i * 16, 255 - i * 16, 128);
+    }
+    for (uint32_t i = 0; i < ILI9341_WIDTH * BAND_HEIGHT / 2; i++) {
+        uint8_t index = (i * 2 % ILI9341_WIDTH) / 20;
+        g_band_4bpp[i] = (index << 4) | index;
+    }
+}
+
+static void bench_bitmap_4bpp(uint32_t i) {
+    (void)i;
+    for (uint16_t y = 0; y < ILI9341_HEIGHT; y += BAND_HEIGHT) {
+        ili9341_draw_bitmap_indexed(0, y, ILI9341_WIDTH, BAND_HEIGHT, 4, g_band_4bpp, g_ramp);
+    }
+}
+
+static void bench_image(uint32_t i) {
+    (void)i;
+    ili9341_draw_image(0, 0, &background);
+}
+
+// A static dashboard built the usual way, panels and boxes drawn over a
+// cleared screen, replayed from a display list as recorded and optimized
+
+#define PANEL_BG 0x10A3     // RGB 20, 20, 28
+
+static void draw_dashboard(void) {
+    ili9341_fill_screen(BLACK);
+    ili9341_fill_rect(0, 0, ILI9341_WIDTH, 35, PANEL_BG);
+    ili9341_draw_line(0, 35, ILI9341_WIDTH - 1, 35, DARKGREY);
+    ili9341_draw_string(10, 12, "ODO", DARKGREY, PANEL_BG, 1);
+    ili9341_draw_string(10, 22, "12345", WHITE, PANEL_BG, 1);
+    ili9341_draw_string(250, 12, "FUEL", DARKGREY, PANEL_BG, 1);
+
+    for (uint16_t i = 0; i < 4; i++) {
+        uint16_t x = 10 + i * 78;
+        ili9341_fill_rect(x, 50, 70, 80, PANEL_BG);
+        ili9341_draw_rect(x, 50, 70, 80, DARKGREY);
+        ili9341_fill_rect(x + 10, 110, 50, 10, GREEN);
+        ili9341_fill_rect(x + 10, 100, 50, 10, GREEN);
+        ili9341_draw_string(x + 8, 60, "CH", WHITE, PANEL_BG, 2);
+    }
+
+    ili9341_fill_rect(60, 150, 200, 70, PANEL_BG);
+    ili9341_fill_rect(70, 160, 180, 50, BLACK);
+    ili9341_draw_string(100, 175, "READY", GREEN, BLACK, 3);
+}
+
+static uint8_t g_dashboard_arena[2][4096];
+static ili9341_dlist_t g_dashboard[2];
+
+static void make_dashboard(void) {
+    for (int i = 0; i < 2; i++) {
+        ili9341_dlist_init(&g_dashboard[i], g_dashboard_arena[i], sizeof(g_dashboard_arena[i]));
+        ili9341_dlist_begin(&g_dashboard[i]);
+        draw_dashboard();
+        ili9341_dlist_end();
+    }
+    ili9341_dlist_optimize(&g_dashboard[1]);
+}
+
+static void bench_dashboard(uint32_t i) {
+    (void)i;
+    ili9341_dlist_replay(&g_dashboard[0]);
+}
+
+static void bench_dashboard_optimized(uint32_t i) {
+    (void)i;
+    ili9341_dlist_replay(&g_dashboard[1]);
+}
+
+// Hardware scroll by one line, then fill the line that came into view.
+// Whole turns of the ring, so the screen ends up unscrolled.
+static void bench_scroll_line(uint32_t i) {
+    ili9341_scroll(1);
+    ili9341_fill_rect(0, ili9341_scroll_y(ILI9341_HEIGHT - 1), ILI9341_WIDTH, 1, bench_color(i));
+}
+
+// Console output, one 40-character line per call. The console takes over
+// the scroll area when it starts.
+static ili9341_console_t g_console;
+static const char console_line[] = "t=%05lu speed 123 km/h rpm 4567 gear 3.\n";
+
+static void bench_console(uint32_t i) {
+    if (i == 0) ili9341_console_init(&g_console, 0, 0, 1, GREEN, BLACK);
+    ili9341_console_printf(&g_console, console_line, (unsigned long)i);
+}
+
+static const benchmark_t benchmarks[] = {
+    { "horizontal lines", "lines", 2000, 1, bench_hline },
+    { "vertical lines", "lines", 2000, 1, bench_vline },
+    { "random lines", "lines", 2000, 1, bench_line },
+    { "rect outlines", "rects", 2000, 1, bench_rect },
+    { "clipped circles", "circles", 2000, 1, bench_clipped_circle },
+    { "opaque text", "chars", 500, 20, bench_text_opaque },
+    { "transparent text", "chars", 500, 20, bench_text_transparent },
+    { "bitmap", "frames", 20, 1, bench_bitmap },
+    { "native bitmap", "frames", 20, 1, bench_bitmap_be },
+    { "native bitmap async", "frames", 20, 1, bench_bitmap_be_async },
+    { "4-bpp bitmap", "frames", 20, 1, bench_bitmap_4bpp },
+    { "compressed image", "frames", 20, 1, bench_image },
+    { "static screen", "frames", 20, 1, bench_dashboard },
+    { "optimized screen", "frames", 20, 1, bench_dashboard_optimized },
+    { "scroll by line", "lines", 3 * ILI9341_HEIGHT, 1, bench_scroll_line },
+    { "console", "chars", 600, 40, bench_console },     // Last: leaves the screen scrolled
+};
+
+// Fixed-point math, timed per call next to the libm equivalents
+//
+// Each call takes a different argument so nothing is hoisted out of the
+// loop; the results are summed into a volatile so nothing is discarded.
+
+#define MATH_CALLS 20000
+#define ANGLE_TO_RADIANS (6.283185307179586 / ILI9341_ANGLE_TURN)
+
+typedef struct {
+    const char *name;
+    int32_t (*run)(int32_t i);
+} math_benchmark_t;
+
+static volatile int32_t g_sink;
+
+static int32_t math_overhead(int32_t i) {
+    return i;
+}
+
+static int32_t math_sin(int32_t i) {
+    return ili9341_sin(i * 97);
+}
+
+static int32_t math_atan2(int32_t i) {
+    return ili9341_atan2((i & 0xFF) - 128, ((i >> 8) & 0xFF) - 128);
+}
+
+static int32_t math_polar(int32_t i) {
+    int32_t x, y;
+    ili9341_polar(160, 120, 100, i * 97, &x, &y);
+    return x + y;
+}
+
+static int32_t libm_sinf(int32_t i) {
+    return (int32_t)(sinf((float)(i * 97 * ANGLE_TO_RADIANS)) * 32768.0f);
+}
+
+static int32_t libm_sin(int32_t i) {
+    return (int32_t)(sin(i * 97 * ANGLE_TO_RADIANS) * 32768.0);
+}
+
+static int32_t libm_atan2f(int32_t i) {
+    return (int32_t)(atan2f((i & 0xFF) - 128, ((i >> 8) & 0xFF) - 128) * 10430.378f);
+}
+
+static const math_benchmark_t math_benchmarks[] = {
+    { "call overhead", math_overhead },
+    { "ili9341_sin", math_sin },
+    { "ili9341_atan2", math_atan2 },
+    { "ili9341_polar", math_polar },
+    { "sinf (libm)", libm_sinf },
+    { "sin (libm, double)", libm_sin },
+    { "atan2f (libm)", libm_atan2f },
+};
+
+static void run_math_benchmark(const math_benchmark_t *b) {
+    int32_t sum = 0;
+    
+    uint64_t start = now_us();
+    for (int32_t i = 0; i < MATH_CALLS; i++) {
+        sum += b->run(i);
+    }
+    uint64_t elapsed = now_us() - start;
+    g_sink = sum;
+    
+    double ns = elapsed * 1000.0 / MATH_CALLS;
+    printf("%-22s %10.1f ns/call", b->name, ns);
+#ifndef ILI9341_HOST
+    printf("  %6.0f cycles", ns * clock_get_hz(clk_sys) / 1e9);
+#endif
+    printf("\n");
+}
+
+// Limits the fixed-point functions must stay within. Sines are checked in
+// Q15 steps from the correctly rounded value, so table and interpolation
+// rounding may each cost half a step but no more.
+#define SIN_MAX_STEPS 1
+#define ATAN2_MAX_ERROR 1.5         // Angle units
+#define POLAR_MAX_ERROR 1.0         // Pixels at r = 100
+
+// Worst-case error of the fixed-point functions against double-precision
+// libm; false if any limit is exceeded
+static bool check_math_accuracy(void) {
+    double sin_error = 0, atan2_error = 0, polar_error = 0;
+    int32_t sin_steps = 0;
+    
+    for (int32_t a = 0; a < ILI9341_ANGLE_TURN; a++) {
+        double rad = a * ANGLE_TO_RADIANS;
+        int32_t s = ili9341_sin(a), c = ili9341_cos(a);
+        double e = fabs(s - sin(rad) * 32768.0);
+        if (e > sin_error) sin_error = e;
+        e = fabs(c - cos(rad) * 32768.0);
+        if (e > sin_error) sin_error = e;
+        int32_t steps = abs(s - (int32_t)lround(sin(rad) * 32768.0));
+        if (steps > sin_steps) sin_steps = steps;
+        steps = abs(c - (int32_t)lround(cos(rad) * 32768.0));
+        if (steps > sin_steps) sin_steps = steps;
+        
+        if (a % 7 == 0) {
+            int32_t x, y;
+            ili9341_polar(0, 0, 100, a, &x, &y);
+            e = hypot(x - 100 * cos(rad), y - 100 * sin(rad));
+            if (e > polar_error) polar_error = e;
+        }
+    }
+    
+    for (int32_t y = -300; y <= 300; y += 3) {
+        for (int32_t x = -300; x <= 300; x += 3) {
+            if (x == 0 && y == 0) continue;
+            double e = fabs(ili9341_atan2(y, x) - atan2(y, x) / ANGLE_TO_RADIANS);
+            if (e > ILI9341_ANGLE_TURN / 2) e = ILI9341_ANGLE_TURN - e;
+            if (e > atan2_error) atan2_error = e;
+        }
+    }
+    
+    bool sin_ok = sin_steps <= SIN_MAX_STEPS;
+    bool atan2_ok = atan2_error <= ATAN2_MAX_ERROR;
+    bool polar_ok = polar_error <= POLAR_MAX_ERROR;
+    printf("sin/cos max error      %10.2f LSB (Q15), %ld from rounded%s\n", sin_error,
+           (long)sin_steps, sin_ok ? "" : "  FAIL");
+    printf("atan2 max error        %10.2f units (%.4f degrees)%s\n", atan2_error,
+           atan2_error * 360.0 / ILI9341_ANGLE_TURN, atan2_ok ? "" : "  FAIL");
+    printf("polar max error        %10.2f pixels at r = 100%s\n", polar_error, polar_ok ? "" : "  FAIL");
+    return sin_ok && atan2_ok && polar_ok;
+}
+
+static void run_benchmark(const benchmark_t *b) {
+    g_seed = 1;
+    ili9341_fill_screen(BLACK);
+#ifdef ILI9341_HOST
+    ili9341_host_reset_counters(&host);
+#endif
+
+    uint64_t start = now_us();
+    for (uint32_t i = 0; i < b->calls; i++) {
+        b->run(i);
+    }
+    ili9341_async_wait();
+    uint64_t elapsed = now_us() - start;
+    if (elapsed == 0) elapsed = 1;
+
+    double units = (double)b->calls * b->units;
+    printf("%-22s %10.0f %s/s", b->name, units * 1e6 / elapsed, b->unit);
+#ifdef ILI9341_HOST
+    double bytes = host.bytes / units;
+    printf("  %8.1f bytes  %8.0f %s/s at %d MHz", bytes, BAUDRATE / 8.0 / bytes, b->unit, BAUDRATE / 1000000);
+#endif
+    printf("\n");
+}
+
+int main() {
+#ifdef ILI9341_HOST
+    ili9341_config_t display_config = {
+        .transport = &ili9341_host_transport,
+        .transport_ctx = &host,
+    };
+#else
+    stdio_init_all();
+    sleep_ms(2000);
+
+    ili9341_config_t display_config = {
+        .spi_port = spi0,
+        .cs_pin = 17,
+        .dc_pin = 16,
+        .rst_pin = 20,
+        .mosi_pin = 19,
+        .sck_pin = 18,
+        .baudrate = BAUDRATE
+    };
+#endif
+
+    ili9341_init(&display_config);
+    make_band();
+    make_band_4bpp();
+    make_dashboard();
+    printf("Benchmark Starting...\n");
+
+#ifdef ILI9341_STATS
+    ili9341_stats_reset();
+#endif
+    for (size_t i = 0; i < sizeof(benchmarks) / sizeof(benchmarks[0]); i++) {
+        run_benchmark(&benchmarks[i]);
+    }
+#ifdef ILI9341_STATS
+    ili9341_stats_t stats;
+    ili9341_stats_snapshot(&stats);
+    ili9341_stats_print(&stats);
+#endif
+    for (size_t i = 0; i < sizeof(math_benchmarks) / sizeof(math_benchmarks[0]); i++) {
+        run_math_benchmark(&math_benchmarks[i]);
+    }
+    bool accurate = check_math_accuracy();
+
+    printf("Benchmark complete!\n");
+#ifndef ILI9341_HOST
+    while (1) {
+        sleep_ms(1000);
+    }
+#endif
+    return accurate ? 0 : 1;
+}
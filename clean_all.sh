@@ -41,6 +41,7 @@ clean_directory "01_text_demo"
 clean_directory "02_graphics_demo"
 clean_directory "03_image_demo"
 clean_directory "04_speedometer"
+clean_directory "05_benchmark"
 
 echo ""
 echo "=========================================="
@@ -115,7 +115,7 @@ echo ""
 echo "Cleaning example build directories..."
 echo ""
 
-EXAMPLES=("00_bare_minimum_test" "00_chip_id_test" "00_dc_pin_test" "01_text_demo" "02_graphics_demo" "03_image_demo" "04_speedometer")
+EXAMPLES=("00_bare_minimum_test" "00_chip_id_test" "00_dc_pin_test" "01_text_demo" "02_graphics_demo" "03_image_demo" "04_speedometer" "05_benchmark")
 
 for example in "${EXAMPLES[@]}"; do
     if [ -d "$example" ]; then
@@ -1,331 +1,933 @@
+#if defined(ILI9341_HOST) && defined(ILI9341_STATS)
+#define _POSIX_C_SOURCE 200809L     // clock_gettime() for the counters
+#endif
+
 #include "ili9341.h"
 #include "font.h"
+#include "ili9341_math.h"
+#include <stdlib.h>
 #include <string.h>
 #include <math.h>
+#ifdef ILI9341_STATS
+#include <stdio.h>
+#ifdef ILI9341_HOST
+#include <time.h>
+#endif
+#endif
 
 ili9341_config_t *g_display_config = NULL;
 
-// Low-level SPI functions
-static inline void cs_select() {
-    gpio_put(g_display_config->cs_pin, 0);
+// The calls without a display draw on the selected one; ili9341_init()
+// uses the built-in one
+static ili9341_display_t g_default_display;
+static ili9341_display_t *g_display = &g_default_display;
+static ili9341_display_t *g_displays = NULL;
+
+// Hand the call to the display's capture hook, if recording, and return
+// from the primitive
+#define CAPTURE(d, ...) \
+    do { \
+        if ((d)->capture) { \
+            ili9341_op_t op_ = { __VA_ARGS__ }; \
+            (d)->capture((d)->capture_ctx, &op_); \
+            return; \
+        } \
+    } while (0)
+
+// Instrumentation
+//
+// STAT_PRIMITIVE() opens a scope for the rest of the function; GCC and
+// Clang run stat_leave() on every way out of it. Only the outermost scope
+// on a display counts a call and time and takes the traffic of everything
+// nested.
+#ifdef ILI9341_STATS
+#define STAT_NONE 0xFF
+
+typedef struct {
+    ili9341_display_t *d;
+    bool outer;
+    uint64_t start;
+} stat_scope_t;
+
+static inline uint64_t stat_now_us(void) {
+#ifdef ILI9341_HOST
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+#else
+    return time_us_64();
+#endif
 }
 
-static inline void cs_deselect() {
-    gpio_put(g_display_config->cs_pin, 1);
+static inline stat_scope_t stat_enter(ili9341_display_t *d, uint8_t id) {
+    stat_scope_t scope = { d, false, 0 };
+    
+    if (d->stats.current == STAT_NONE) {
+        d->stats.current = id;
+        d->stats.counters.primitive[id].calls++;
+        scope.outer = true;
+        scope.start = stat_now_us();
+    }
+    return scope;
 }
 
-static inline void dc_command() {
-    gpio_put(g_display_config->dc_pin, 0);
+static inline void stat_leave(stat_scope_t *scope) {
+    if (!scope->outer) return;
+    
+    ili9341_display_t *d = scope->d;
+    d->stats.counters.primitive[d->stats.current].time_us += stat_now_us() - scope->start;
+    d->stats.current = STAT_NONE;
 }
 
-static inline void dc_data() {
-    gpio_put(g_display_config->dc_pin, 1);
+static inline ili9341_stats_entry_t *stat_entry(ili9341_display_t *d) {
+    uint8_t current = d->stats.current;
+    return &d->stats.counters.primitive[current == STAT_NONE ? ILI9341_STAT_OTHER : current];
 }
 
-void ili9341_write_command(uint8_t cmd) {
-    dc_command();
-    cs_select();
-    spi_write_blocking(g_display_config->spi_port, &cmd, 1);
-    cs_deselect();
+// A window set up by display_window(): CASET and PASET carry four
+// parameter bytes each, and every command byte drops DC and raises it again
+static inline void stat_window(ili9341_stats_entry_t *e, uint8_t commands) {
+    e->windows++;
+    if (commands) e->bytes += 5 * commands - 4;
+    e->dc_toggles += 2 * commands;
 }
 
-void ili9341_write_data(uint8_t data) {
-    dc_data();
-    cs_select();
-    spi_write_blocking(g_display_config->spi_port, &data, 1);
-    cs_deselect();
+#define STAT_PRIMITIVE(d, id) \
+    stat_scope_t stat_scope_ __attribute__((cleanup(stat_leave))) = stat_enter((d), (id))
+#define STAT_TRANSACTION(d) (stat_entry(d)->transactions++)
+#define STAT_COMMAND(d) \
+    do { \
+        stat_entry(d)->bytes++; \
+        stat_entry(d)->dc_toggles += 2; \
+    } while (0)
+#define STAT_BYTES(d, n)    (stat_entry(d)->bytes += (n))
+#define STAT_PIXELS(d, n)   (stat_entry(d)->pixels += (n))
+#define STAT_WINDOW(d, commands) stat_window(stat_entry(d), (commands))
+
+// DMA jobs start from IRQ or worker context, whatever primitive the
+// caller is inside. Their traffic goes to the display's own entry, which
+// is only touched with the transport lock held.
+static inline void stat_async(ili9341_display_t *d, uint8_t commands, uint32_t count) {
+    ili9341_stats_entry_t *e = &d->async.stats;
+    
+    e->transactions++;
+    stat_window(e, commands);
+    e->bytes += 2 * (uint64_t)count;
+    e->pixels += count;
 }
+#define STAT_ASYNC(d, commands, count) stat_async((d), (commands), (count))
+#else
+#define STAT_PRIMITIVE(d, id) do { } while (0)
+#define STAT_TRANSACTION(d) do { } while (0)
+#define STAT_COMMAND(d)     do { } while (0)
+#define STAT_BYTES(d, n)    do { } while (0)
+#define STAT_PIXELS(d, n)   do { } while (0)
+#define STAT_WINDOW(d, commands) ((void)(commands))
+#define STAT_ASYNC(d, commands, count) ((void)(commands))
+#endif
 
-void ili9341_write_data16(uint16_t data) {
-    uint8_t buffer[2];
-    buffer[0] = data >> 8;
-    buffer[1] = data & 0xFF;
-    dc_data();
-    cs_select();
-    spi_write_blocking(g_display_config->spi_port, buffer, 2);
-    cs_deselect();
+// Each display caches the address window the controller currently holds
+// and the GRAM address the next pixel will land on. CASET/PASET are
+// skipped when unchanged, and a pixel that lands on the cursor while RAMWR
+// is still active is sent as bare data. Raw command writes drop the cache.
+static inline void window_invalidate(ili9341_display_t *d) {
+    d->window.valid = false;
+    d->window.ram_write = false;
 }
 
-void ili9341_reset(void) {
-    gpio_put(g_display_config->rst_pin, 1);
-    sleep_ms(5);
-    gpio_put(g_display_config->rst_pin, 0);
-    sleep_ms(20);
-    gpio_put(g_display_config->rst_pin, 1);
-    sleep_ms(150);
+// Move the cursor past count pixels, wrapping inside the window like GRAM
+static void window_advance(ili9341_display_t *d, uint32_t count) {
+    uint32_t w = d->window.x1 - d->window.x0 + 1;
+    uint32_t h = d->window.y1 - d->window.y0 + 1;
+    uint32_t offset = (uint32_t)(d->window.cy - d->window.y0) * w + (d->window.cx - d->window.x0);
+    
+    offset = (offset + count) % (w * h);
+    d->window.cx = d->window.x0 + offset % w;
+    d->window.cy = d->window.y0 + offset / w;
 }
 
-void ili9341_init(ili9341_config_t *config) {
-    g_display_config = config;
+static void display_async_wait(ili9341_display_t *d) {
+    while (d->async.pending) {
+    }
+}
+
+// Whether two displays go out over the same wires, so that one's queued
+// transfers must finish before the other may use the bus
+static bool display_shares_bus(const ili9341_display_t *a, const ili9341_display_t *b) {
+    if (a->transport != b->transport) return false;
+    if (a->transport_ctx == b->transport_ctx) return true;
+    return a->config->spi_port && a->config->spi_port == b->config->spi_port;
+}
+
+// Wait for the queues of the other displays on d's bus
+static void display_claim_bus(ili9341_display_t *d) {
+    for (ili9341_display_t *other = g_displays; other; other = other->next) {
+        if (other != d && other->async.pending && display_shares_bus(other, d)) {
+            display_async_wait(other);
+        }
+    }
+}
+
+// Low-level bus functions
+static inline void bus_begin(ili9341_display_t *d) {
+    // Blocking drawing must not interleave with a queued transfer
+    if (d->async.pending) display_async_wait(d);
+    if (d->shares_bus) display_claim_bus(d);
+    d->transport->begin(d->transport_ctx);
+    STAT_TRANSACTION(d);
+}
+
+static inline void bus_end(ili9341_display_t *d) {
+    d->transport->end(d->transport_ctx);
+}
+
+static inline void bus_command(ili9341_display_t *d, uint8_t cmd) {
+    d->transport->write_command(d->transport_ctx, cmd);
+    STAT_COMMAND(d);
+}
+
+static inline void bus_data(ili9341_display_t *d, const uint8_t *data, size_t len) {
+    d->transport->write_data(d->transport_ctx, data, len);
+    STAT_BYTES(d, len);
+}
+
+static inline void bus_pixels(ili9341_display_t *d, const uint16_t *pixels, size_t count) {
+    d->transport->write_pixels(d->transport_ctx, pixels, count);
+    STAT_BYTES(d, 2 * count);
+}
+
+static inline void bus_fill(ili9341_display_t *d, uint16_t color, size_t count) {
+    d->transport->fill_pixels(d->transport_ctx, color, count);
+    STAT_BYTES(d, 2 * count);
+}
+
+void ili9341_write_command_on(ili9341_display_t *d, uint8_t cmd) {
+    STAT_PRIMITIVE(d, ILI9341_STAT_COMMAND);
+    bus_begin(d);
+    window_invalidate(d);
+    bus_command(d, cmd);
+    bus_end(d);
+}
+
+void ili9341_write_data_on(ili9341_display_t *d, uint8_t data) {
+    STAT_PRIMITIVE(d, ILI9341_STAT_COMMAND);
+    bus_begin(d);
+    d->window.ram_write = false;
+    bus_data(d, &data, 1);
+    bus_end(d);
+}
+
+void ili9341_write_data16_on(ili9341_display_t *d, uint16_t data) {
+    STAT_PRIMITIVE(d, ILI9341_STAT_COMMAND);
+    bus_begin(d);
+    bus_pixels(d, &data, 1);
+    bus_end(d);
+    if (d->window.ram_write) window_advance(d, 1);
+}
+
+void ili9341_write_command_data_on(ili9341_display_t *d, uint8_t cmd, const uint8_t *params, size_t len) {
+    STAT_PRIMITIVE(d, ILI9341_STAT_COMMAND);
+    bus_begin(d);
+    window_invalidate(d);
+    bus_command(d, cmd);
+    if (len) bus_data(d, params, len);
+    bus_end(d);
+}
+
+void ili9341_write_command_stream_on(ili9341_display_t *d, const uint8_t *stream, size_t len) {
+    STAT_PRIMITIVE(d, ILI9341_STAT_COMMAND);
+    size_t i = 0;
+    
+    bus_begin(d);
+    window_invalidate(d);
+    while (i + 2 <= len) {
+        uint8_t count = stream[i + 1];
+        bus_command(d, stream[i]);
+        if (count) bus_data(d, &stream[i + 2], count);
+        i += 2 + count;
+    }
+    bus_end(d);
+}
+
+// Send CASET/PASET/RAMWR inside the current transaction, skipping whatever
+// the controller already holds. CS stays asserted and DC is left high, so
+// pixel data can follow immediately. Returns the number of commands sent.
+static uint8_t display_window(ili9341_display_t *d, uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1) {
+    const ili9341_transport_t *t = d->transport;
+    bool cols_same = d->window.valid && d->window.x0 == x0 && d->window.x1 == x1;
+    bool pages_same = d->window.valid && d->window.y0 == y0 && d->window.y1 == y1;
+    
+    // The cursor is parked at the start of a row and the new window is made
+    // of the same columns over rows the current one still covers: data just
+    // continues, and GRAM wraps to each next row exactly as it would in
+    // the smaller window
+    if (cols_same && d->window.ram_write && d->window.cx == x0 && d->window.cy == y0 &&
+        y1 <= d->window.y1) {
+        return 0;
+    }
+    
+    uint8_t commands = 1;
+    if (!cols_same) {
+        uint8_t cols[4] = { x0 >> 8, x0 & 0xFF, x1 >> 8, x1 & 0xFF };
+        t->write_command(d->transport_ctx, ILI9341_CASET);
+        t->write_data(d->transport_ctx, cols, 4);
+        commands++;
+    }
+    if (!pages_same) {
+        uint8_t pages[4] = { y0 >> 8, y0 & 0xFF, y1 >> 8, y1 & 0xFF };
+        t->write_command(d->transport_ctx, ILI9341_PASET);
+        t->write_data(d->transport_ctx, pages, 4);
+        commands++;
+    }
+    t->write_command(d->transport_ctx, ILI9341_RAMWR);
     
-    // Initialize SPI
-    spi_init(config->spi_port, config->baudrate);
-    gpio_set_function(config->mosi_pin, GPIO_FUNC_SPI);
-    gpio_set_function(config->sck_pin, GPIO_FUNC_SPI);
+    d->window.valid = true;
+    d->window.ram_write = true;
+    d->window.x0 = x0;
+    d->window.y0 = y0;
+    d->window.x1 = x1;
+    d->window.y1 = y1;
+    d->window.cx = x0;
+    d->window.cy = y0;
+    return commands;
+}
+
+static inline void bus_window(ili9341_display_t *d, uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1) {
+    STAT_WINDOW(d, display_window(d, x0, y0, x1, y1));
+}
+
+void ili9341_reset_on(ili9341_display_t *d) {
+    d->transport->reset(d->transport_ctx);
+}
+
+// Power-on register setup: command, parameter count, parameters
+static const uint8_t init_commands[] = {
+    0xEF, 3, 0x03, 0x80, 0x02,
+    0xCF, 3, 0x00, 0xC1, 0x30,
+    0xED, 4, 0x64, 0x03, 0x12, 0x81,
+    0xE8, 3, 0x85, 0x00, 0x78,
+    0xCB, 5, 0x39, 0x2C, 0x00, 0x34, 0x02,
+    0xF7, 1, 0x20,
+    0xEA, 2, 0x00, 0x00,
+    0xC0, 1, 0x23,                  // Power control, VRH[5:0]
+    0xC1, 1, 0x10,                  // Power control, SAP[2:0];BT[3:0]
+    0xC5, 2, 0x3e, 0x28,            // VCM control
+    0xC7, 1, 0x86,                  // VCM control2
+    ILI9341_MADCTL, 1, ILI9341_MADCTL_MY | ILI9341_MADCTL_BGR,     // ILI9341_ROTATION_0
+    ILI9341_PIXFMT, 1, 0x55,        // 16bit color
+    0xB1, 2, 0x00, 0x18,
+    0xB6, 3, 0x08, 0x82, 0x27,      // Display Function Control
+    0xF2, 1, 0x00,                  // 3Gamma Function Disable
+    0x26, 1, 0x01,                  // Gamma curve selected
+    0xE0, 15,                       // Set Gamma
+    0x0F, 0x31, 0x2B, 0x0C, 0x0E, 0x08, 0x4E, 0xF1,
+    0x37, 0x07, 0x10, 0x03, 0x0E, 0x09, 0x00,
+    0xE1, 15,                       // Set Gamma
+    0x00, 0x0E, 0x14, 0x03, 0x11, 0x07, 0x31, 0xC1,
+    0x48, 0x08, 0x0F, 0x0C, 0x31, 0x36, 0x0F,
+};
+
+// Displays
+
+void ili9341_display_init(ili9341_display_t *display, ili9341_config_t *config) {
+    ili9341_display_t *d = display;
     
-    // Initialize control pins
-    gpio_init(config->cs_pin);
-    gpio_set_dir(config->cs_pin, GPIO_OUT);
-    gpio_put(config->cs_pin, 1);
+    // Resolve the transport
+    d->config = config;
+#ifdef ILI9341_HOST
+    d->transport = config->transport;
+#else
+    d->transport = config->transport ? config->transport : &ili9341_pico_transport;
+#endif
+    d->transport_ctx = config->transport_ctx ? config->transport_ctx : config;
     
-    gpio_init(config->dc_pin);
-    gpio_set_dir(config->dc_pin, GPIO_OUT);
+    // The panel comes out of reset unrotated, with the whole screen
+    // scrolling, unscrolled
+    d->native_width = ILI9341_WIDTH;
+    d->native_height = ILI9341_HEIGHT;
+    d->width = ILI9341_WIDTH;
+    d->height = ILI9341_HEIGHT;
+    d->rotation = ILI9341_ROTATION_0;
+    window_invalidate(d);
+    d->scroll.top = 0;
+    d->scroll.area = ILI9341_HEIGHT;
+    d->scroll.offset = 0;
+    d->clip.depth = 0;
+    d->target = &ili9341_panel_target;
+    d->target_ctx = d;
+    d->capture = NULL;
+    d->capture_ctx = NULL;
+    memset(&d->spans, 0, sizeof(d->spans));
+    d->async.head = 0;
+    d->async.count = 0;
+    d->async.pending = 0;
+#ifdef ILI9341_STATS
+    memset(&d->async.stats, 0, sizeof(d->async.stats));
+    memset(&d->stats.counters, 0, sizeof(d->stats.counters));
+    d->stats.current = STAT_NONE;
+#endif
     
-    gpio_init(config->rst_pin);
-    gpio_set_dir(config->rst_pin, GPIO_OUT);
+    ili9341_display_t **link = &g_displays;
+    while (*link && *link != d) link = &(*link)->next;
+    if (!*link) {
+        d->next = NULL;
+        *link = d;
+    }
+    d->shares_bus = false;
+    for (ili9341_display_t *other = g_displays; other; other = other->next) {
+        if (other != d && display_shares_bus(other, d)) other->shares_bus = d->shares_bus = true;
+    }
+    ili9341_display_select(d);
+    
+    // Bring up the bus and control pins
+    if (d->shares_bus) display_claim_bus(d);
+    d->transport->init(d->transport_ctx);
     
     // Reset display
-    ili9341_reset();
-    
-    // Initialization sequence
-    ili9341_write_command(0xEF);
-    ili9341_write_data(0x03);
-    ili9341_write_data(0x80);
-    ili9341_write_data(0x02);
-    
-    ili9341_write_command(0xCF);
-    ili9341_write_data(0x00);
-    ili9341_write_data(0xC1);
-    ili9341_write_data(0x30);
-    
-    ili9341_write_command(0xED);
-    ili9341_write_data(0x64);
-    ili9341_write_data(0x03);
-    ili9341_write_data(0x12);
-    ili9341_write_data(0x81);
-    
-    ili9341_write_command(0xE8);
-    ili9341_write_data(0x85);
-    ili9341_write_data(0x00);
-    ili9341_write_data(0x78);
-    
-    ili9341_write_command(0xCB);
-    ili9341_write_data(0x39);
-    ili9341_write_data(0x2C);
-    ili9341_write_data(0x00);
-    ili9341_write_data(0x34);
-    ili9341_write_data(0x02);
-    
-    ili9341_write_command(0xF7);
-    ili9341_write_data(0x20);
-    
-    ili9341_write_command(0xEA);
-    ili9341_write_data(0x00);
-    ili9341_write_data(0x00);
-    
-    ili9341_write_command(0xC0);    // Power control
-    ili9341_write_data(0x23);       // VRH[5:0]
-    
-    ili9341_write_command(0xC1);    // Power control
-    ili9341_write_data(0x10);       // SAP[2:0];BT[3:0]
-    
-    ili9341_write_command(0xC5);    // VCM control
-    ili9341_write_data(0x3e);
-    ili9341_write_data(0x28);
-    
-    ili9341_write_command(0xC7);    // VCM control2
-    ili9341_write_data(0x86);
-    
-    ili9341_write_command(ILI9341_MADCTL);
-    ili9341_write_data(0x88);
-    
-    ili9341_write_command(ILI9341_PIXFMT);
-    ili9341_write_data(0x55);       // 16bit color
-    
-    ili9341_write_command(0xB1);
-    ili9341_write_data(0x00);
-    ili9341_write_data(0x18);
-    
-    ili9341_write_command(0xB6);    // Display Function Control
-    ili9341_write_data(0x08);
-    ili9341_write_data(0x82);
-    ili9341_write_data(0x27);
-    
-    ili9341_write_command(0xF2);    // 3Gamma Function Disable
-    ili9341_write_data(0x00);
-    
-    ili9341_write_command(0x26);    // Gamma curve selected
-    ili9341_write_data(0x01);
-    
-    ili9341_write_command(0xE0);    // Set Gamma
-    ili9341_write_data(0x0F);
-    ili9341_write_data(0x31);
-    ili9341_write_data(0x2B);
-    ili9341_write_data(0x0C);
-    ili9341_write_data(0x0E);
-    ili9341_write_data(0x08);
-    ili9341_write_data(0x4E);
-    ili9341_write_data(0xF1);
-    ili9341_write_data(0x37);
-    ili9341_write_data(0x07);
-    ili9341_write_data(0x10);
-    ili9341_write_data(0x03);
-    ili9341_write_data(0x0E);
-    ili9341_write_data(0x09);
-    ili9341_write_data(0x00);
-    
-    ili9341_write_command(0xE1);    // Set Gamma
-    ili9341_write_data(0x00);
-    ili9341_write_data(0x0E);
-    ili9341_write_data(0x14);
-    ili9341_write_data(0x03);
-    ili9341_write_data(0x11);
-    ili9341_write_data(0x07);
-    ili9341_write_data(0x31);
-    ili9341_write_data(0xC1);
-    ili9341_write_data(0x48);
-    ili9341_write_data(0x08);
-    ili9341_write_data(0x0F);
-    ili9341_write_data(0x0C);
-    ili9341_write_data(0x31);
-    ili9341_write_data(0x36);
-    ili9341_write_data(0x0F);
-    
-    ili9341_write_command(ILI9341_SLPOUT);
-    sleep_ms(120);
-    
-    ili9341_write_command(ILI9341_DISPON);
-}
-
-void ili9341_set_window(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1) {
-    ili9341_write_command(ILI9341_CASET);
-    ili9341_write_data(x0 >> 8);
-    ili9341_write_data(x0 & 0xFF);
-    ili9341_write_data(x1 >> 8);
-    ili9341_write_data(x1 & 0xFF);
-    
-    ili9341_write_command(ILI9341_PASET);
-    ili9341_write_data(y0 >> 8);
-    ili9341_write_data(y0 & 0xFF);
-    ili9341_write_data(y1 >> 8);
-    ili9341_write_data(y1 & 0xFF);
-    
-    ili9341_write_command(ILI9341_RAMWR);
+    ili9341_reset_on(d);
+    
+    // Initialization sequence, one transaction for the whole table
+    ili9341_write_command_stream_on(d, init_commands, sizeof(init_commands));
+    
+    ili9341_write_command_on(d, ILI9341_SLPOUT);
+    d->transport->delay_ms(d->transport_ctx, 120);
+    
+    ili9341_write_command_on(d, ILI9341_DISPON);
 }
 
-void ili9341_fill_screen(uint16_t color) {
-    ili9341_fill_rect(0, 0, ILI9341_WIDTH, ILI9341_HEIGHT, color);
+// Other displays on the same bus are waited for when this one draws
+void ili9341_display_select(ili9341_display_t *display) {
+    g_display = display;
+    g_display_config = display->config;
+}
+
+ili9341_display_t *ili9341_display_current(void) {
+    return g_display;
+}
+
+void ili9341_init(ili9341_config_t *config) {
+    ili9341_display_init(&g_default_display, config);
 }
 
-void ili9341_draw_pixel(uint16_t x, uint16_t y, uint16_t color) {
-    if (x >= ILI9341_WIDTH || y >= ILI9341_HEIGHT) return;
+// MADCTL for each rotation, a quarter turn apart. The driver's original
+// setting is rotation 0; 90 and 270 exchange rows and columns.
+static const uint8_t rotation_madctl[4] = {
+    ILI9341_MADCTL_MY | ILI9341_MADCTL_BGR,
+    ILI9341_MADCTL_MY | ILI9341_MADCTL_MX | ILI9341_MADCTL_MV | ILI9341_MADCTL_BGR,
+    ILI9341_MADCTL_MX | ILI9341_MADCTL_BGR,
+    ILI9341_MADCTL_MV | ILI9341_MADCTL_BGR,
+};
+
+void ili9341_set_rotation_on(ili9341_display_t *d, uint8_t rotation) {
+    STAT_PRIMITIVE(d, ILI9341_STAT_COMMAND);
+    rotation &= 3;
+    
+    // The controller keeps the window in the old orientation's terms
+    bus_begin(d);
+    window_invalidate(d);
+    bus_command(d, ILI9341_MADCTL);
+    bus_data(d, &rotation_madctl[rotation], 1);
+    bus_end(d);
     
-    ili9341_set_window(x, y, x, y);
-    ili9341_write_data16(color);
+    d->rotation = rotation;
+    d->clip.depth = 0;
+    d->width = (rotation & 1) ? d->native_height : d->native_width;
+    d->height = (rotation & 1) ? d->native_width : d->native_height;
+}
+
+uint8_t ili9341_get_rotation_on(const ili9341_display_t *d) {
+    return d->rotation;
+}
+
+uint16_t ili9341_width_on(const ili9341_display_t *d) {
+    return d->width;
 }
 
-// void ili9341_fill_rect(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color) {
-//     if (x >= ILI9341_WIDTH || y >= ILI9341_HEIGHT) return;
-//     if (x + w > ILI9341_WIDTH) w = ILI9341_WIDTH - x;
-//     if (y + h > ILI9341_HEIGHT) h = ILI9341_HEIGHT - y;
+uint16_t ili9341_height_on(const ili9341_display_t *d) {
+    return d->height;
+}
+
+bool ili9341_set_window_on(ili9341_display_t *d, int16_t x0, int16_t y0, int16_t x1, int16_t y1) {
+    if (x0 < 0) x0 = 0;
+    if (y0 < 0) y0 = 0;
+    if (x1 >= d->width) x1 = d->width - 1;
+    if (y1 >= d->height) y1 = d->height - 1;
+    if (x0 > x1 || y0 > y1) return false;
     
-//     ili9341_set_window(x, y, x + w - 1, y + h - 1);
+    STAT_PRIMITIVE(d, ILI9341_STAT_COMMAND);
+    bus_begin(d);
+    bus_window(d, x0, y0, x1, y1);
+    bus_end(d);
+    return true;
+}
+
+// Render targets
+//
+// Every primitive ends up as a pixel or a window streamed in GRAM order.
+// The panel target turns those into bus traffic on the display in ctx;
+// other targets (RAM framebuffer, strip buffers) are installed with
+// ili9341_set_target().
+
+static void panel_pixel(void *ctx, uint16_t x, uint16_t y, uint16_t color) {
+    ili9341_display_t *d = ctx;
     
-//     uint8_t color_buffer[2];
-//     color_buffer[0] = color >> 8;
-//     color_buffer[1] = color & 0xFF;
+    // The window runs to the bottom-right corner so that the next pixel
+    // along the row is a bare data write, and a pixel in the same column
+    // only needs a new PASET.
+    bus_begin(d);
+    if (!d->window.ram_write || d->window.cx != x || d->window.cy != y) {
+        bus_window(d, x, y, d->width - 1, d->height - 1);
+    }
+    bus_pixels(d, &color, 1);
+    bus_end(d);
+    window_advance(d, 1);
+    STAT_PIXELS(d, 1);
+}
+
+static void panel_window(void *ctx, uint16_t x, uint16_t y, uint16_t w, uint16_t h) {
+    ili9341_display_t *d = ctx;
+    bus_begin(d);
+    bus_window(d, x, y, x + w - 1, y + h - 1);
+    d->window.streamed = 0;
+}
+
+static void panel_write(void *ctx, const uint16_t *pixels, size_t count) {
+    ili9341_display_t *d = ctx;
+    bus_pixels(d, pixels, count);
+    d->window.streamed += count;
+    STAT_PIXELS(d, count);
+}
+
+static void panel_write_be(void *ctx, const uint8_t *bytes, size_t count) {
+    ili9341_display_t *d = ctx;
+    bus_data(d, bytes, count * 2);
+    d->window.streamed += count;
+    STAT_PIXELS(d, count);
+}
+
+static void panel_repeat(void *ctx, uint16_t color, size_t count) {
+    ili9341_display_t *d = ctx;
+    bus_fill(d, color, count);
+    d->window.streamed += count;
+    STAT_PIXELS(d, count);
+}
+
+static void panel_end(void *ctx) {
+    ili9341_display_t *d = ctx;
+    bus_end(d);
+    window_advance(d, d->window.streamed);
+}
+
+const ili9341_target_t ili9341_panel_target = {
+    .pixel = panel_pixel,
+    .window = panel_window,
+    .write = panel_write,
+    .write_be = panel_write_be,
+    .repeat = panel_repeat,
+    .end = panel_end,
+};
+
+void ili9341_set_target_on(ili9341_display_t *d, const ili9341_target_t *target, void *ctx) {
+    d->target = target ? target : &ili9341_panel_target;
+    d->target_ctx = target ? ctx : d;
+}
+
+bool ili9341_target_is_panel_on(const ili9341_display_t *d) {
+    return d->target == &ili9341_panel_target;
+}
+
+// Recorded drawing
+
+void ili9341_set_capture_on(ili9341_display_t *d, ili9341_capture_t capture, void *ctx) {
+    d->capture = capture;
+    d->capture_ctx = capture ? ctx : NULL;
+}
+
+bool ili9341_capture_on(ili9341_display_t *d, const ili9341_op_t *op) {
+    if (!d->capture) return false;
     
-//     dc_data();
-//     cs_select();
-//     for (uint32_t i = 0; i < w * h; i++) {
-//         spi_write_blocking(g_display_config->spi_port, color_buffer, 2);
-//     }
-//     cs_deselect();
-// }
+    d->capture(d->capture_ctx, op);
+    return true;
+}
+
+void ili9341_op_draw_on(ili9341_display_t *d, const ili9341_op_t *op) {
+    switch (op->type) {
+        case ILI9341_OP_PIXEL:
+            ili9341_draw_pixel_on(d, op->x, op->y, op->color);
+            break;
+        case ILI9341_OP_LINE:
+            ili9341_draw_line_on(d, op->x, op->y, (int16_t)op->w, (int16_t)op->h, op->color);
+            break;
+        case ILI9341_OP_RECT:
+            ili9341_draw_rect_on(d, op->x, op->y, op->w, op->h, op->color);
+            break;
+        case ILI9341_OP_FILL_RECT:
+            ili9341_fill_rect_on(d, op->x, op->y, op->w, op->h, op->color);
+            break;
+        case ILI9341_OP_CIRCLE:
+            ili9341_draw_circle_on(d, op->x, op->y, op->w, op->color);
+            break;
+        case ILI9341_OP_FILL_CIRCLE:
+            ili9341_fill_circle_on(d, op->x, op->y, op->w, op->color);
+            break;
+        case ILI9341_OP_FILL_ELLIPSE:
+            ili9341_fill_ellipse_on(d, op->x, op->y, op->w, op->h, op->color);
+            break;
+        case ILI9341_OP_FILL_RING:
+            ili9341_fill_ring_on(d, op->x, op->y, op->w, op->h, op->color);
+            break;
+        case ILI9341_OP_FILL_SECTOR:
+            ili9341_fill_sector_on(d, op->x, op->y, op->w, op->h, op->start, op->end, op->color);
+            break;
+        case ILI9341_OP_FILL_SPANS:
+            ili9341_fill_spans_on(d, (const ili9341_span_t *)op->data, (size_t)op->start, op->color);
+            break;
+        case ILI9341_OP_CHAR:
+            ili9341_draw_char_on(d, op->x, op->y, op->c, op->color, op->bg, op->size);
+            break;
+        case ILI9341_OP_STRING:
+            ili9341_draw_string_on(d, op->x, op->y, (const char *)op->data, op->color, op->bg, op->size);
+            break;
+        case ILI9341_OP_BITMAP:
+            ili9341_draw_bitmap_on(d, op->x, op->y, op->w, op->h, (const uint16_t *)op->data);
+            break;
+        case ILI9341_OP_BITMAP_BE:
+            ili9341_draw_bitmap_be_on(d, op->x, op->y, op->w, op->h, (const uint8_t *)op->data);
+            break;
+        case ILI9341_OP_MASK:
+            ili9341_draw_bitmap_mask_on(d, op->x, op->y, op->w, op->h, (const uint8_t *)op->data,
+                                        op->color, op->bg, op->size);
+            break;
+        case ILI9341_OP_INDEXED:
+            ili9341_draw_bitmap_indexed_on(d, op->x, op->y, op->w, op->h, op->size,
+                                           (const uint8_t *)op->data, op->palette);
+            break;
+        case ILI9341_OP_CUSTOM:
+            op->draw(d, op);
+            break;
+    }
+}
 
-void ili9341_fill_rect(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color) {
-    // 1. Validation & Clipping
-    if (x >= ILI9341_WIDTH || y >= ILI9341_HEIGHT) return;
-    if (x + w > ILI9341_WIDTH) w = ILI9341_WIDTH - x;
-    if (y + h > ILI9341_HEIGHT) h = ILI9341_HEIGHT - y;
+// Hardware vertical scrolling
+
+// The scroll registers leave the address window alone; only a RAMWR data
+// stream cannot continue past them
+static void scroll_command(ili9341_display_t *d, uint8_t cmd, const uint8_t *params, size_t len) {
+    STAT_PRIMITIVE(d, ILI9341_STAT_COMMAND);
+    bus_begin(d);
+    d->window.ram_write = false;
+    bus_command(d, cmd);
+    bus_data(d, params, len);
+    bus_end(d);
+}
+
+void ili9341_scroll_define_on(ili9341_display_t *d, uint16_t top_fixed, uint16_t bottom_fixed) {
+    uint16_t rows = d->native_height;
+    
+    // Keep at least one scrolling row
+    if (top_fixed > rows - 1) top_fixed = rows - 1;
+    if (bottom_fixed > rows - 1 - top_fixed) bottom_fixed = rows - 1 - top_fixed;
+    
+    uint16_t area = rows - top_fixed - bottom_fixed;
+    uint8_t params[6] = {
+        top_fixed >> 8, top_fixed & 0xFF,
+        area >> 8, area & 0xFF,
+        bottom_fixed >> 8, bottom_fixed & 0xFF,
+    };
+    scroll_command(d, ILI9341_VSCRDEF, params, sizeof(params));
+    
+    d->scroll.top = top_fixed;
+    d->scroll.area = area;
+    ili9341_scroll_set_on(d, 0);
+}
+
+void ili9341_scroll_set_on(ili9341_display_t *d, uint16_t offset) {
+    offset %= d->scroll.area;
     
-    // 2. Set the window
-    ili9341_set_window(x, y, x + w - 1, y + h - 1);
+    uint16_t start = d->scroll.top + offset;
+    uint8_t params[2] = { start >> 8, start & 0xFF };
+    scroll_command(d, ILI9341_VSCRSADD, params, sizeof(params));
+    d->scroll.offset = offset;
+}
+
+void ili9341_scroll_on(ili9341_display_t *d, int16_t lines) {
+    int32_t offset = ((int32_t)d->scroll.offset + lines) % d->scroll.area;
+    
+    if (offset < 0) offset += d->scroll.area;
+    ili9341_scroll_set_on(d, offset);
+}
+
+uint16_t ili9341_scroll_offset_on(const ili9341_display_t *d) {
+    return d->scroll.offset;
+}
+
+uint16_t ili9341_scroll_y_on(const ili9341_display_t *d, uint16_t y) {
+    if (y < d->scroll.top || y >= d->scroll.top + d->scroll.area) return y;
+    return d->scroll.top + (y - d->scroll.top + d->scroll.offset) % d->scroll.area;
+}
+
+// Clipping
+//
+// Primitives take the clip once, cut to the screen, and pass it to the
+// span and window helpers below, which trim or drop each piece before
+// anything reaches the target.
+
+typedef struct {
+    ili9341_display_t *d;       // Display drawn on
+    int32_t x0, y0, x1, y1;     // Inclusive, empty if x0 > x1 or y0 > y1
+} clip_t;
+
+static inline clip_t clip_current(ili9341_display_t *d) {
+    clip_t c = { d, 0, 0, d->width - 1, d->height - 1 };
     
-    // 3. Prepare the color bytes
-    uint8_t hi = color >> 8;
-    uint8_t lo = color & 0xFF;
+    if (d->clip.depth) {
+        uint8_t top = d->clip.depth - 1;
+        if (d->clip.stack[top].x0 > c.x0) c.x0 = d->clip.stack[top].x0;
+        if (d->clip.stack[top].y0 > c.y0) c.y0 = d->clip.stack[top].y0;
+        if (d->clip.stack[top].x1 < c.x1) c.x1 = d->clip.stack[top].x1;
+        if (d->clip.stack[top].y1 < c.y1) c.y1 = d->clip.stack[top].y1;
+    }
+    return c;
+}
 
-    // 4. Create a "Chunk Buffer" (e.g., 64 bytes = 32 pixels)
-    // This fits easily on the stack and speeds up transfer significantly.
-    const int BATCH_SIZE = 64; 
-    uint8_t buffer[BATCH_SIZE];
+// True if the box x0..x1, y0..y1 lies entirely outside the clip
+static inline bool clip_misses(const clip_t *c, int32_t x0, int32_t y0, int32_t x1, int32_t y1) {
+    return x1 < c->x0 || x0 > c->x1 || y1 < c->y0 || y0 > c->y1;
+}
+
+// Cut a rectangle to the clip; false if nothing is left
+static inline bool clip_rect(const clip_t *c, int32_t *x, int32_t *y, int32_t *w, int32_t *h) {
+    int32_t x1 = *x + *w - 1;
+    int32_t y1 = *y + *h - 1;
+    
+    if (*x < c->x0) *x = c->x0;
+    if (*y < c->y0) *y = c->y0;
+    if (x1 > c->x1) x1 = c->x1;
+    if (y1 > c->y1) y1 = c->y1;
+    if (*x > x1 || *y > y1) return false;
+    
+    *w = x1 - *x + 1;
+    *h = y1 - *y + 1;
+    return true;
+}
 
-    // Fill the buffer with the color pattern once
-    for (int i = 0; i < BATCH_SIZE; i += 2) {
-        buffer[i] = hi;
-        buffer[i+1] = lo;
+bool ili9341_clip_push_on(ili9341_display_t *d, int16_t x, int16_t y, uint16_t w, uint16_t h) {
+    if (d->clip.depth >= ILI9341_CLIP_DEPTH) return false;
+    
+    int32_t x0 = x, y0 = y;
+    int32_t x1 = (int32_t)x + w - 1;
+    int32_t y1 = (int32_t)y + h - 1;
+    
+    if (d->clip.depth) {
+        uint8_t top = d->clip.depth - 1;
+        if (d->clip.stack[top].x0 > x0) x0 = d->clip.stack[top].x0;
+        if (d->clip.stack[top].y0 > y0) y0 = d->clip.stack[top].y0;
+        if (d->clip.stack[top].x1 < x1) x1 = d->clip.stack[top].x1;
+        if (d->clip.stack[top].y1 < y1) y1 = d->clip.stack[top].y1;
+    }
+    if (x1 > INT16_MAX) x1 = INT16_MAX;
+    if (y1 > INT16_MAX) y1 = INT16_MAX;
+    if (x0 > x1 || y0 > y1) {
+        x0 = y0 = 0;
+        x1 = y1 = -1;
     }
+    
+    uint8_t top = d->clip.depth++;
+    d->clip.stack[top].x0 = x0;
+    d->clip.stack[top].y0 = y0;
+    d->clip.stack[top].x1 = x1;
+    d->clip.stack[top].y1 = y1;
+    return true;
+}
+
+void ili9341_clip_pop_on(ili9341_display_t *d) {
+    if (d->clip.depth) d->clip.depth--;
+}
+
+void ili9341_clip_reset_on(ili9341_display_t *d) {
+    d->clip.depth = 0;
+}
+
+bool ili9341_clip_get_on(ili9341_display_t *d, ili9341_span_t *clip) {
+    clip_t c = clip_current(d);
+    
+    clip->x = c.x0;
+    clip->y = c.y0;
+    clip->w = (c.x0 <= c.x1 && c.y0 <= c.y1) ? c.x1 - c.x0 + 1 : 0;
+    clip->h = clip->w ? c.y1 - c.y0 + 1 : 0;
+    return d->clip.depth != 0;
+}
+
+void ili9341_fill_screen_on(ili9341_display_t *d, uint16_t color) {
+    ili9341_fill_rect_on(d, 0, 0, d->width, d->height, color);
+}
+
+void ili9341_draw_pixel_on(ili9341_display_t *d, int16_t x, int16_t y, uint16_t color) {
+    CAPTURE(d, .type = ILI9341_OP_PIXEL, .x = x, .y = y, .color = color);
+    STAT_PRIMITIVE(d, ILI9341_STAT_PIXEL);
+    
+    clip_t c = clip_current(d);
+    if (x < c.x0 || x > c.x1 || y < c.y0 || y > c.y1) return;
+    
+    d->target->pixel(d->target_ctx, x, y, color);
+}
+
+// One window of a single color, cut to the clip. Every filled shape and
+// span ends up here.
+static void fill_clipped(const clip_t *c, int32_t x, int32_t y, int32_t w, int32_t h, uint16_t color) {
+    if (w <= 0 || h <= 0 || !clip_rect(c, &x, &y, &w, &h)) return;
+    
+    const ili9341_target_t *t = c->d->target;
+    void *ctx = c->d->target_ctx;
+    t->window(ctx, x, y, w, h);
+    t->repeat(ctx, color, (uint32_t)w * h);
+    t->end(ctx);
+}
+
+void ili9341_fill_rect_on(ili9341_display_t *d, int16_t x, int16_t y, uint16_t w, uint16_t h, uint16_t color) {
+    CAPTURE(d, .type = ILI9341_OP_FILL_RECT, .x = x, .y = y, .w = w, .h = h, .color = color);
+    STAT_PRIMITIVE(d, ILI9341_STAT_FILL_RECT);
+    
+    clip_t c = clip_current(d);
+    fill_clipped(&c, x, y, w, h, color);
+}
+
+// Lines
+//
+// Axis-aligned lines are a single fill window. Other lines are run-slice
+// Bresenham: pixel i along the major axis sits on minor step
+// round(i * minor / major), so each minor step is one run of pixels along
+// the major axis, sent as one span. Run ends come from an incremental
+// quotient and remainder, with no per-pixel work.
 
-    dc_data();
-    cs_select();
+static void line_runs(const clip_t *c, int32_t x0, int32_t y0, int32_t major, int32_t minor,
+                      int32_t step, bool x_major, uint16_t color) {
+    // Run k ends at pixel floor(((2k + 1) * major - 1) / (2 * minor))
+    int32_t den = 2 * minor;
+    int32_t q_step = (2 * major) / den;
+    int32_t r_step = (2 * major) % den;
+    int32_t q = (major - 1) / den;
+    int32_t r = (major - 1) % den;
+    int32_t start = 0;
 
-    // 5. Calculate total bytes needed
-    uint32_t pixels_total = (uint32_t)w * h;
-    uint32_t bytes_remaining = pixels_total * 2;
+    for (int32_t k = 0; k <= minor; k++) {
+        int32_t end = (k == minor) ? major : q;
+        int32_t len = end - start + 1;
+
+        if (x_major) {
+            fill_clipped(c, x0 + start, y0 + k * step, len, 1, color);
+        } else {
+            fill_clipped(c, x0 + k * step, y0 + start, 1, len, color);
+        }
 
-    // 6. Write in large chunks
-    while (bytes_remaining > 0) {
-        // If we have more than a full buffer left, send the whole buffer
-        if (bytes_remaining >= BATCH_SIZE) {
-            spi_write_blocking(g_display_config->spi_port, buffer, BATCH_SIZE);
-            bytes_remaining -= BATCH_SIZE;
-        } 
-        // Otherwise, send only what is left
-        else {
-            spi_write_blocking(g_display_config->spi_port, buffer, bytes_remaining);
-            bytes_remaining = 0;
+        start = end + 1;
+        q += q_step;
+        r += r_step;
+        if (r >= den) {
+            r -= den;
+            q++;
         }
     }
-    
-    cs_deselect();
 }
 
-void ili9341_draw_line(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uint16_t color) {
-    int16_t dx = abs(x1 - x0);
-    int16_t dy = abs(y1 - y0);
-    int16_t sx = (x0 < x1) ? 1 : -1;
-    int16_t sy = (y0 < y1) ? 1 : -1;
-    int16_t err = dx - dy;
+void ili9341_draw_line_on(ili9341_display_t *d, int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) {
+    CAPTURE(d, .type = ILI9341_OP_LINE, .x = x0, .y = y0, .w = (uint16_t)x1, .h = (uint16_t)y1, .color = color);
+    STAT_PRIMITIVE(d, ILI9341_STAT_LINE);
     
-    while (1) {
-        ili9341_draw_pixel(x0, y0, color);
-        
-        if (x0 == x1 && y0 == y1) break;
-        
-        int16_t e2 = 2 * err;
-        if (e2 > -dy) {
-            err -= dy;
-            x0 += sx;
+    clip_t c = clip_current(d);
+    int32_t dx = abs((int32_t)x1 - x0);
+    int32_t dy = abs((int32_t)y1 - y0);
+    
+    if (clip_misses(&c, x0 < x1 ? x0 : x1, y0 < y1 ? y0 : y1, x0 > x1 ? x0 : x1, y0 > y1 ? y0 : y1)) return;
+    
+    // Walk from the lower end of the major axis so A-B and B-A match
+    if (dy == 0) {
+        fill_clipped(&c, x0 < x1 ? x0 : x1, y0, dx + 1, 1, color);
+    } else if (dx == 0) {
+        fill_clipped(&c, x0, y0 < y1 ? y0 : y1, 1, dy + 1, color);
+    } else if (dx >= dy) {
+        if (x0 > x1) {
+            int16_t t = x0; x0 = x1; x1 = t;
+            t = y0; y0 = y1; y1 = t;
         }
-        if (e2 < dx) {
-            err += dx;
-            y0 += sy;
+        line_runs(&c, x0, y0, dx, dy, y1 > y0 ? 1 : -1, true, color);
+    } else {
+        if (y0 > y1) {
+            int16_t t = x0; x0 = x1; x1 = t;
+            t = y0; y0 = y1; y1 = t;
         }
+        line_runs(&c, x0, y0, dy, dx, x1 > x0 ? 1 : -1, false, color);
+    }
+}
+
+void ili9341_draw_rect_on(ili9341_display_t *d, int16_t x, int16_t y, uint16_t w, uint16_t h, uint16_t color) {
+    CAPTURE(d, .type = ILI9341_OP_RECT, .x = x, .y = y, .w = w, .h = h, .color = color);
+    STAT_PRIMITIVE(d, ILI9341_STAT_RECT);
+    
+    if (w == 0 || h == 0) return;
+    
+    // Four non-overlapping edges, one window each
+    clip_t c = clip_current(d);
+    fill_clipped(&c, x, y, w, 1, color);
+    if (h > 1) fill_clipped(&c, x, (int32_t)y + h - 1, w, 1, color);
+    if (h > 2) {
+        fill_clipped(&c, x, (int32_t)y + 1, 1, h - 2, color);
+        if (w > 1) fill_clipped(&c, (int32_t)x + w - 1, (int32_t)y + 1, 1, h - 2, color);
     }
 }
 
-void ili9341_draw_rect(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color) {
-    ili9341_draw_line(x, y, x + w - 1, y, color);
-    ili9341_draw_line(x + w - 1, y, x + w - 1, y + h - 1, color);
-    ili9341_draw_line(x + w - 1, y + h - 1, x, y + h - 1, color);
-    ili9341_draw_line(x, y + h - 1, x, y, color);
+// Circle outlines
+//
+// Midpoint circle, drawn as runs: the points of one octant that share a
+// row form a horizontal run, mirrored to the rows y0 +- y, and the same run
+// turned on its side gives the vertical runs in columns x0 +- y. Each run
+// is one span.
+
+static void circle_runs(const clip_t *c, int32_t x0, int32_t y0, int32_t xa, int32_t xb, int32_t y,
+                        uint16_t color) {
+    int32_t len = xb - xa + 1;
+    
+    if (xa == 0) {
+        // The run crosses the axis: one span each side instead of two
+        fill_clipped(c, x0 - xb, y0 - y, 2 * xb + 1, 1, color);
+        fill_clipped(c, x0 - xb, y0 + y, 2 * xb + 1, 1, color);
+        fill_clipped(c, x0 - y, y0 - xb, 1, 2 * xb + 1, color);
+        fill_clipped(c, x0 + y, y0 - xb, 1, 2 * xb + 1, color);
+        return;
+    }
+    fill_clipped(c, x0 + xa, y0 - y, len, 1, color);
+    fill_clipped(c, x0 - xb, y0 - y, len, 1, color);
+    fill_clipped(c, x0 + xa, y0 + y, len, 1, color);
+    fill_clipped(c, x0 - xb, y0 + y, len, 1, color);
+    fill_clipped(c, x0 - y, y0 + xa, 1, len, color);
+    fill_clipped(c, x0 - y, y0 - xb, 1, len, color);
+    fill_clipped(c, x0 + y, y0 + xa, 1, len, color);
+    fill_clipped(c, x0 + y, y0 - xb, 1, len, color);
 }
 
-void ili9341_draw_circle(uint16_t x0, uint16_t y0, uint16_t r, uint16_t color) {
-    int16_t f = 1 - r;
-    int16_t ddF_x = 1;
-    int16_t ddF_y = -2 * r;
-    int16_t x = 0;
-    int16_t y = r;
+void ili9341_draw_circle_on(ili9341_display_t *d, int16_t x0, int16_t y0, uint16_t r, uint16_t color) {
+    CAPTURE(d, .type = ILI9341_OP_CIRCLE, .x = x0, .y = y0, .w = r, .color = color);
+    STAT_PRIMITIVE(d, ILI9341_STAT_CIRCLE);
+    
+    clip_t c = clip_current(d);
+    if (clip_misses(&c, x0 - r, y0 - r, x0 + r, y0 + r)) return;
+    if (r == 0) {
+        fill_clipped(&c, x0, y0, 1, 1, color);
+        return;
+    }
     
-    ili9341_draw_pixel(x0, y0 + r, color);
-    ili9341_draw_pixel(x0, y0 - r, color);
-    ili9341_draw_pixel(x0 + r, y0, color);
-    ili9341_draw_pixel(x0 - r, y0, color);
+    int32_t f = 1 - r;
+    int32_t ddF_x = 1;
+    int32_t ddF_y = -2 * r;
+    int32_t x = 0;
+    int32_t y = r;
+    int32_t run = 0;        // First x of the run on row y
     
     while (x < y) {
         if (f >= 0) {
+            // The next point steps down a row: the run so far is complete
+            circle_runs(&c, x0, y0, run, x, y, color);
+            run = x + 1;
             y--;
             ddF_y += 2;
             f += ddF_y;
@@ -333,72 +935,1103 @@ void ili9341_draw_circle(uint16_t x0, uint16_t y0, uint16_t r, uint16_t color) {
         x++;
         ddF_x += 2;
         f += ddF_x;
-        
-        ili9341_draw_pixel(x0 + x, y0 + y, color);
-        ili9341_draw_pixel(x0 - x, y0 + y, color);
-        ili9341_draw_pixel(x0 + x, y0 - y, color);
-        ili9341_draw_pixel(x0 - x, y0 - y, color);
-        ili9341_draw_pixel(x0 + y, y0 + x, color);
-        ili9341_draw_pixel(x0 - y, y0 + x, color);
-        ili9341_draw_pixel(x0 + y, y0 - x, color);
-        ili9341_draw_pixel(x0 - y, y0 - x, color);
-    }
-}
-
-void ili9341_fill_circle(uint16_t x0, uint16_t y0, uint16_t r, uint16_t color) {
-    for (int16_t y = -r; y <= r; y++) {
-        for (int16_t x = -r; x <= r; x++) {
-            if (x * x + y * y <= r * r) {
-                ili9341_draw_pixel(x0 + x, y0 + y, color);
-            }
+    }
+    circle_runs(&c, x0, y0, run, x, y, color);
+}
+
+// Span rasterizer for filled circles, ellipses and rings
+//
+// Shapes are symmetric about their centre row, so only the half-widths of
+// rows 0..r are computed. Rows that share a half-width are drawn as one
+// rectangle above and one below the centre (a single one for the run
+// through the centre), each a single window.
+
+// Each display keeps circle half-width tables for recently used radii;
+// the demos redraw the same few radii constantly
+
+#if ILI9341_SPAN_CACHE_SLOTS < 2
+#error "ILI9341_SPAN_CACHE_SLOTS must be at least 2, rings use two tables"
+#endif
+#if ILI9341_SPAN_CACHE_RADIUS > 255
+#error "ILI9341_SPAN_CACHE_RADIUS must fit the 8-bit tables"
+#endif
+
+// Walks the half-widths of an ellipse x^2*ry^2 + y^2*rx^2 <= rx^2*ry^2 for
+// rows dy = 0, 1, 2... in order, or reads them from a cached table
+typedef struct {
+    const uint8_t *table;
+    int64_t a, b, limit;    // Row test: x*x*a + dy*dy*b <= limit
+    int32_t x;
+} span_rows_t;
+
+static void span_rows_ellipse(span_rows_t *rows, uint16_t rx, uint16_t ry) {
+    rows->table = NULL;
+    rows->a = (int64_t)ry * ry;
+    rows->b = (int64_t)rx * rx;
+    rows->limit = rows->a * rows->b;
+    rows->x = rx;
+
+    // The degenerate ellipse is its axis
+    if (rx == 0 || ry == 0) {
+        rows->a = rows->b = 0;
+    }
+}
+
+static inline int32_t span_row(span_rows_t *rows, int32_t dy) {
+    if (rows->table) return rows->table[dy];
+
+    while (rows->x > 0 && (int64_t)rows->x * rows->x * rows->a + (int64_t)dy * dy * rows->b > rows->limit) {
+        rows->x--;
+    }
+    return rows->x;
+}
+
+// Rows are walked in order unless d has r cached; NULL skips the cache
+static void span_rows_circle(span_rows_t *rows, uint16_t r, ili9341_display_t *d) {
+    span_rows_ellipse(rows, r, r);
+    rows->a = rows->b = 1;
+    rows->limit = (int64_t)r * r;
+    if (!d || r > ILI9341_SPAN_CACHE_RADIUS) return;
+
+    ili9341_span_table_t *slot = &d->spans.table[0];
+    for (int i = 0; i < ILI9341_SPAN_CACHE_SLOTS; i++) {
+        ili9341_span_table_t *t = &d->spans.table[i];
+        if (t->valid && t->radius == r) {
+            t->last_used = ++d->spans.clock;
+            rows->table = t->half;
+            return;
         }
+        if (!t->valid || (slot->valid && t->last_used < slot->last_used)) slot = t;
+    }
+
+    // Miss: fill the least recently used slot
+    for (int32_t dy = 0; dy <= r; dy++) {
+        slot->half[dy] = span_row(rows, dy);
     }
+    slot->valid = true;
+    slot->radius = r;
+    slot->last_used = ++d->spans.clock;
+    rows->table = slot->half;
 }
 
-void ili9341_draw_char(uint16_t x, uint16_t y, char c, uint16_t color, uint16_t bg, uint8_t size) {
-    if (c < 32 || c > 126) c = '?';
+// Fill columns x0+left..x0+right on rows dy0..dy1 above and below y0
+static void fill_mirrored(const clip_t *c, int32_t x0, int32_t y0, int32_t dy0, int32_t dy1,
+                          int32_t left, int32_t right, uint16_t color) {
+    int32_t w = right - left + 1;
+
+    if (w <= 0) return;
+    if (dy0 == 0) {
+        fill_clipped(c, x0 + left, y0 - dy1, w, 2 * dy1 + 1, color);
+        return;
+    }
+    fill_clipped(c, x0 + left, y0 - dy1, w, dy1 - dy0 + 1, color);
+    fill_clipped(c, x0 + left, y0 + dy0, w, dy1 - dy0 + 1, color);
+}
+
+// Fill rows 0..height of a shape; inner, if given, is a hole of the given height
+static void fill_span_rows(const clip_t *c, int32_t x0, int32_t y0, span_rows_t *outer, int32_t height,
+                           span_rows_t *inner, int32_t inner_height, uint16_t color) {
+    int32_t dy = 0;
+    int32_t ho = span_row(outer, 0);
+    int32_t hi = (inner && inner_height >= 0) ? span_row(inner, 0) : -1;
+
+    while (dy <= height) {
+        // Extend the run while both half-widths stay the same
+        int32_t end = dy;
+        int32_t next_o = 0, next_i = -1;
+        while (end < height) {
+            next_o = span_row(outer, end + 1);
+            next_i = (inner && end + 1 <= inner_height) ? span_row(inner, end + 1) : -1;
+            if (next_o != ho || next_i != hi) break;
+            end++;
+        }
+
+        if (hi < 0) {
+            fill_mirrored(c, x0, y0, dy, end, -ho, ho, color);
+        } else {
+            fill_mirrored(c, x0, y0, dy, end, -ho, -hi - 1, color);
+            fill_mirrored(c, x0, y0, dy, end, hi + 1, ho, color);
+        }
+
+        dy = end + 1;
+        ho = next_o;
+        hi = next_i;
+    }
+}
+
+void ili9341_fill_circle_on(ili9341_display_t *d, int16_t x0, int16_t y0, uint16_t r, uint16_t color) {
+    CAPTURE(d, .type = ILI9341_OP_FILL_CIRCLE, .x = x0, .y = y0, .w = r, .color = color);
+    STAT_PRIMITIVE(d, ILI9341_STAT_FILL_CIRCLE);
     
-    for (uint8_t i = 0; i < 5; i++) {
-        uint8_t line = font[c - 32][i];
-        for (uint8_t j = 0; j < 8; j++, line >>= 1) {
-            if (line & 1) {
-                if (size == 1) {
-                    ili9341_draw_pixel(x + i, y + j, color);
-                } else {
-                    ili9341_fill_rect(x + i * size, y + j * size, size, size, color);
-                }
-            } else if (bg != color) {
-                if (size == 1) {
-                    ili9341_draw_pixel(x + i, y + j, bg);
+    clip_t c = clip_current(d);
+    if (clip_misses(&c, x0 - r, y0 - r, x0 + r, y0 + r)) return;
+    
+    span_rows_t rows;
+    span_rows_circle(&rows, r, d);
+    fill_span_rows(&c, x0, y0, &rows, r, NULL, -1, color);
+}
+
+void ili9341_fill_ellipse_on(ili9341_display_t *d, int16_t x0, int16_t y0, uint16_t rx, uint16_t ry,
+                             uint16_t color) {
+    CAPTURE(d, .type = ILI9341_OP_FILL_ELLIPSE, .x = x0, .y = y0, .w = rx, .h = ry, .color = color);
+    STAT_PRIMITIVE(d, ILI9341_STAT_FILL_ELLIPSE);
+    
+    clip_t c = clip_current(d);
+    if (clip_misses(&c, x0 - rx, y0 - ry, x0 + rx, y0 + ry)) return;
+    
+    span_rows_t rows;
+    span_rows_ellipse(&rows, rx, ry);
+    fill_span_rows(&c, x0, y0, &rows, ry, NULL, -1, color);
+}
+
+void ili9341_fill_ring_on(ili9341_display_t *d, int16_t x0, int16_t y0, uint16_t r_outer, uint16_t r_inner,
+                          uint16_t color) {
+    CAPTURE(d, .type = ILI9341_OP_FILL_RING, .x = x0, .y = y0, .w = r_outer, .h = r_inner, .color = color);
+    STAT_PRIMITIVE(d, ILI9341_STAT_FILL_RING);
+    
+    if (r_inner >= r_outer) return;
+    
+    clip_t c = clip_current(d);
+    if (clip_misses(&c, x0 - r_outer, y0 - r_outer, x0 + r_outer, y0 + r_outer)) return;
+    
+    span_rows_t outer, inner;
+    span_rows_circle(&outer, r_outer, d);
+    span_rows_circle(&inner, r_inner, d);
+    fill_span_rows(&c, x0, y0, &outer, r_outer, &inner, r_inner, color);
+}
+
+// Annular sectors
+//
+// Each row of a ring is one or two intervals (either side of the hole). Each
+// ray bounds a half-plane, which on a given row is a half-line found with
+// one integer division against the ray's Q15 direction; the sector is the
+// intersection of the two half-planes (sweeps up to half a turn) or their
+// union (wider sweeps). Rows whose intervals match the row above extend its
+// spans downwards.
+
+#define SECTOR_INF 0x7FFF
+#define SECTOR_MAX_PARTS 4
+
+typedef struct {
+    int32_t x0, x1;
+} interval_t;
+
+typedef void (*span_emit_t)(void *ctx, const ili9341_span_t *span);
+
+static inline int32_t div_floor(int32_t a, int32_t b) {
+    int32_t q = a / b;
+    if ((a % b != 0) && ((a < 0) != (b < 0))) q--;
+    return q;
+}
+
+// Columns of row dy where c * x <= k
+static bool half_line(int32_t c, int32_t k, interval_t *out) {
+    out->x0 = -SECTOR_INF;
+    out->x1 = SECTOR_INF;
+    if (c > 0) {
+        out->x1 = div_floor(k, c);
+    } else if (c < 0) {
+        out->x0 = -div_floor(-k, c);
+    } else if (k < 0) {
+        return false;
+    }
+    return true;
+}
+
+static size_t clip_intervals(const interval_t *a, size_t na, const interval_t *b, size_t nb,
+                             interval_t *out) {
+    size_t n = 0;
+    for (size_t i = 0; i < na; i++) {
+        for (size_t j = 0; j < nb; j++) {
+            int32_t x0 = a[i].x0 > b[j].x0 ? a[i].x0 : b[j].x0;
+            int32_t x1 = a[i].x1 < b[j].x1 ? a[i].x1 : b[j].x1;
+            if (x0 <= x1) out[n++] = (interval_t){ x0, x1 };
+        }
+    }
+    return n;
+}
+
+// d, if given, supplies cached circle tables
+static void sector_walk(ili9341_display_t *d, int32_t x0, int32_t y0, uint16_t r_outer, uint16_t r_inner,
+                        int32_t start_angle, int32_t end_angle, span_emit_t emit, void *ctx) {
+    int32_t sweep = end_angle - start_angle;
+    if (sweep < 0 || r_inner >= r_outer || r_outer > 255) return;
+
+    // Half-widths of every row of the ring, outer and (-1 outside) inner
+    uint8_t outer_half[256];
+    int16_t inner_half[256];
+    span_rows_t outer, inner;
+    span_rows_circle(&outer, r_outer, d);
+    span_rows_circle(&inner, r_inner, d);
+    for (int32_t dy = 0; dy <= r_outer; dy++) {
+        outer_half[dy] = span_row(&outer, dy);
+        inner_half[dy] = (dy <= r_inner) ? span_row(&inner, dy) : -1;
+    }
+
+    int32_t ax = ili9341_cos(start_angle), ay = ili9341_sin(start_angle);
+    int32_t bx = ili9341_cos(end_angle), by = ili9341_sin(end_angle);
+
+    ili9341_span_t open[SECTOR_MAX_PARTS];
+    size_t open_count = 0;
+
+    for (int32_t dy = -(int32_t)r_outer; dy <= r_outer + 1; dy++) {
+        interval_t parts[SECTOR_MAX_PARTS];
+        size_t count = 0;
+
+        if (dy <= r_outer) {
+            int32_t ho = outer_half[abs(dy)], hi = inner_half[abs(dy)];
+            interval_t ring[2] = { { -ho, ho } };
+            size_t ring_count = 1;
+            if (hi >= 0) {
+                ring[0].x1 = -hi - 1;
+                ring[1] = (interval_t){ hi + 1, ho };
+                ring_count = 2;
+            }
+
+            // Start ray: cross(a, p) >= 0; end ray: cross(p, b) >= 0
+            interval_t wedge[2];
+            size_t wedge_count = 0;
+            if (sweep >= ILI9341_ANGLE_TURN) {
+                wedge[wedge_count++] = (interval_t){ -SECTOR_INF, SECTOR_INF };
+            } else {
+                interval_t a, b;
+                bool has_a = half_line(ay, ax * dy, &a);
+                bool has_b = half_line(-by, -bx * dy, &b);
+                if (sweep <= ILI9341_ANGLE_TURN / 2) {
+                    if (has_a && has_b) wedge_count = clip_intervals(&a, 1, &b, 1, wedge);
                 } else {
-                    ili9341_fill_rect(x + i * size, y + j * size, size, size, bg);
+                    if (has_a) wedge[wedge_count++] = a;
+                    if (has_b) wedge[wedge_count++] = b;
+                    if (wedge_count == 2) {
+                        // Sort, then merge when they overlap or touch
+                        if (wedge[1].x0 < wedge[0].x0) {
+                            interval_t t = wedge[0];
+                            wedge[0] = wedge[1];
+                            wedge[1] = t;
+                        }
+                        if (wedge[1].x0 <= wedge[0].x1 + 1) {
+                            if (wedge[1].x1 > wedge[0].x1) wedge[0].x1 = wedge[1].x1;
+                            wedge_count = 1;
+                        }
+                    }
                 }
             }
+            count = clip_intervals(ring, ring_count, wedge, wedge_count, parts);
+        }
+
+        // Same columns as the row above: grow its spans
+        bool same = (count == open_count);
+        for (size_t i = 0; same && i < count; i++) {
+            same = (open[i].x == x0 + parts[i].x0 && open[i].w == parts[i].x1 - parts[i].x0 + 1);
+        }
+        if (same) {
+            for (size_t i = 0; i < open_count; i++) open[i].h++;
+            continue;
+        }
+
+        for (size_t i = 0; i < open_count; i++) emit(ctx, &open[i]);
+        for (size_t i = 0; i < count; i++) {
+            open[i] = (ili9341_span_t){ x0 + parts[i].x0, y0 + dy, parts[i].x1 - parts[i].x0 + 1, 1 };
+        }
+        open_count = count;
+    }
+}
+
+typedef struct {
+    clip_t clip;
+    uint16_t color;
+} span_fill_t;
+
+static void emit_fill(void *ctx, const ili9341_span_t *span) {
+    const span_fill_t *fill = (const span_fill_t *)ctx;
+    fill_clipped(&fill->clip, span->x, span->y, span->w, span->h, fill->color);
+}
+
+typedef struct {
+    ili9341_span_t *spans;
+    size_t max, count;
+} span_list_t;
+
+static void emit_store(void *ctx, const ili9341_span_t *span) {
+    span_list_t *list = (span_list_t *)ctx;
+    if (list->count < list->max) list->spans[list->count] = *span;
+    list->count++;
+}
+
+void ili9341_fill_sector_on(ili9341_display_t *d, int16_t x0, int16_t y0, uint16_t r_outer, uint16_t r_inner,
+                            int32_t start_angle, int32_t end_angle, uint16_t color) {
+    CAPTURE(d, .type = ILI9341_OP_FILL_SECTOR, .x = x0, .y = y0, .w = r_outer, .h = r_inner,
+            .start = start_angle, .end = end_angle, .color = color);
+    STAT_PRIMITIVE(d, ILI9341_STAT_FILL_SECTOR);
+    span_fill_t fill = { clip_current(d), color };
+    
+    if (clip_misses(&fill.clip, x0 - r_outer, y0 - r_outer, x0 + r_outer, y0 + r_outer)) return;
+    sector_walk(d, x0, y0, r_outer, r_inner, start_angle, end_angle, emit_fill, &fill);
+}
+
+size_t ili9341_sector_spans(int16_t x0, int16_t y0, uint16_t r_outer, uint16_t r_inner,
+                            int32_t start_angle, int32_t end_angle, ili9341_span_t *spans, size_t max) {
+    span_list_t list = { spans, max, 0 };
+    sector_walk(NULL, x0, y0, r_outer, r_inner, start_angle, end_angle, emit_store, &list);
+    return list.count;
+}
+
+// Box around every span, for recording. Its size is capped at UINT16_MAX,
+// which from any int16_t origin still reaches past the screen.
+static ili9341_span_t spans_bounds(const ili9341_span_t *spans, size_t count) {
+    int32_t x0 = INT16_MAX, y0 = INT16_MAX, x1 = INT16_MIN, y1 = INT16_MIN;
+    
+    for (size_t i = 0; i < count; i++) {
+        const ili9341_span_t *s = &spans[i];
+        if (s->w == 0 || s->h == 0) continue;
+        if (s->x < x0) x0 = s->x;
+        if (s->y < y0) y0 = s->y;
+        if (s->x + s->w - 1 > x1) x1 = s->x + s->w - 1;
+        if (s->y + s->h - 1 > y1) y1 = s->y + s->h - 1;
+    }
+    if (x0 > x1) return (ili9341_span_t){ 0, 0, 0, 0 };
+    return (ili9341_span_t){ (int16_t)x0, (int16_t)y0,
+                             (uint16_t)(x1 - x0 < UINT16_MAX ? x1 - x0 + 1 : UINT16_MAX),
+                             (uint16_t)(y1 - y0 < UINT16_MAX ? y1 - y0 + 1 : UINT16_MAX) };
+}
+
+void ili9341_fill_spans_on(ili9341_display_t *d, const ili9341_span_t *spans, size_t count, uint16_t color) {
+    if (d->capture) {
+        ili9341_span_t box = spans_bounds(spans, count);
+        CAPTURE(d, .type = ILI9341_OP_FILL_SPANS, .x = box.x, .y = box.y, .w = box.w, .h = box.h,
+                .start = (int32_t)count, .data = spans, .color = color);
+    }
+    STAT_PRIMITIVE(d, ILI9341_STAT_FILL_SPANS);
+    clip_t c = clip_current(d);
+    
+    for (size_t i = 0; i < count; i++) {
+        fill_clipped(&c, spans[i].x, spans[i].y, spans[i].w, spans[i].h, color);
+    }
+}
+
+// Text
+//
+// Characters are 5x8 cells on a 6-pixel advance, scaled by an integer size.
+// Opaque text (bg != color) goes out as one window per call, cut to the
+// clip: each glyph row is expanded into a line buffer from the first
+// visible column, gaps between characters included, and sent once per
+// visible scaled line. Transparent text only touches foreground pixels,
+// sent as one span per run of set columns in each glyph row.
+
+static inline const uint8_t *glyph(char c) {
+    if (c < 32 || c > 126) c = '?';
+    return font[c - 32];
+}
+
+static void text_opaque(const clip_t *c, int32_t x, int32_t y, const char *str, size_t len,
+                        uint16_t color, uint16_t bg, uint8_t size) {
+    // No trailing gap after the last character
+    int32_t cx = x, cy = y;
+    int32_t cw = (int32_t)len * 6 * size - size;
+    int32_t ch = 8 * size;
+    
+    if (!clip_rect(c, &cx, &cy, &cw, &ch)) return;
+    
+    int32_t skip = cx - x;          // Columns cut off on the left
+    int32_t line = cy - y;          // Scaled line of the text at the window top
+    int32_t last = line + ch;
+    const ili9341_target_t *t = c->d->target;
+    void *ctx = c->d->target_ctx;
+    uint16_t *buffer = c->d->line;
+    
+    t->window(ctx, cx, cy, cw, ch);
+    while (line < last) {
+        uint8_t row = line / size;
+        uint16_t *dst = buffer;
+        int32_t left = cw;
+        size_t i = skip / (6 * size);
+        uint8_t col = (skip / size) % 6;
+        int32_t n = size - skip % size;
+        const uint8_t *g = glyph(str[i]);
+        
+        while (left > 0) {
+            uint16_t pixel = (col < 5 && (g[col] >> row) & 1) ? color : bg;
+            if (n > left) n = left;
+            for (int32_t k = 0; k < n; k++) *dst++ = pixel;
+            left -= n;
+            n = size;
+            if (++col == 6 && left > 0) {
+                col = 0;
+                g = glyph(str[++i]);
+            }
+        }
+        
+        int32_t end = (int32_t)(row + 1) * size;
+        if (end > last) end = last;
+        for (; line < end; line++) {
+            t->write(ctx, buffer, cw);
+        }
+    }
+    t->end(ctx);
+}
+
+static void text_transparent(const clip_t *c, int32_t x, int32_t y, const char *str, size_t len,
+                             uint16_t color, uint8_t size) {
+    for (uint8_t row = 0; row < 8; row++) {
+        int32_t py = y + row * size;
+        if (py > c->y1) break;
+        if (py + size <= c->y0) continue;
+        
+        for (size_t i = 0; i < len; i++) {
+            int32_t cx = x + (int32_t)i * 6 * size;
+            if (cx > c->x1) break;
+            if (cx + 5 * size <= c->x0) continue;
+            
+            const uint8_t *g = glyph(str[i]);
+            for (uint8_t col = 0; col < 5; col++) {
+                if (!((g[col] >> row) & 1)) continue;
+                
+                uint8_t run = col;
+                while (run + 1 < 5 && ((g[run + 1] >> row) & 1)) run++;
+                fill_clipped(c, cx + col * size, py, (run - col + 1) * size, size, color);
+                col = run;
+            }
+        }
+    }
+}
+
+static void text_draw(ili9341_display_t *d, int16_t x, int16_t y, const char *str, size_t len,
+                      uint16_t color, uint16_t bg, uint8_t size) {
+    if (len == 0 || size == 0) return;
+    
+    clip_t c = clip_current(d);
+    if (clip_misses(&c, x, y, x + (int32_t)len * 6 * size - size - 1, y + 8 * size - 1)) return;
+    
+    if (bg == color) {
+        text_transparent(&c, x, y, str, len, color, size);
+    } else {
+        text_opaque(&c, x, y, str, len, color, bg, size);
+    }
+}
+
+void ili9341_draw_char_on(ili9341_display_t *d, int16_t x, int16_t y, char c, uint16_t color, uint16_t bg,
+                          uint8_t size) {
+    CAPTURE(d, .type = ILI9341_OP_CHAR, .x = x, .y = y, .c = c, .color = color, .bg = bg, .size = size);
+    STAT_PRIMITIVE(d, ILI9341_STAT_CHAR);
+    
+    text_draw(d, x, y, &c, 1, color, bg, size);
+}
+
+void ili9341_draw_string_on(ili9341_display_t *d, int16_t x, int16_t y, const char *str, uint16_t color,
+                            uint16_t bg, uint8_t size) {
+    CAPTURE(d, .type = ILI9341_OP_STRING, .x = x, .y = y, .data = str, .color = color, .bg = bg, .size = size);
+    STAT_PRIMITIVE(d, ILI9341_STAT_STRING);
+    
+    text_draw(d, x, y, str, strlen(str), color, bg, size);
+}
+
+void ili9341_draw_bitmap_on(ili9341_display_t *d, int16_t x, int16_t y, uint16_t w, uint16_t h,
+                            const uint16_t *data) {
+    CAPTURE(d, .type = ILI9341_OP_BITMAP, .x = x, .y = y, .w = w, .h = h, .data = data);
+    STAT_PRIMITIVE(d, ILI9341_STAT_BITMAP);
+    
+    clip_t c = clip_current(d);
+    int32_t cx = x, cy = y, cw = w, ch = h;
+    if (!clip_rect(&c, &cx, &cy, &cw, &ch)) return;
+    
+    // Stream the visible part of each row
+    data += (uint32_t)(cy - y) * w + (cx - x);
+    d->target->window(d->target_ctx, cx, cy, cw, ch);
+    if (cw == w) {
+        d->target->write(d->target_ctx, data, (uint32_t)w * ch);
+    } else {
+        for (int32_t row = 0; row < ch; row++) {
+            d->target->write(d->target_ctx, data + (uint32_t)row * w, cw);
+        }
+    }
+    d->target->end(d->target_ctx);
+}
+
+// Stream big-endian pixels to the target, converting for targets that
+// only take native pixels
+static void target_write_be(ili9341_display_t *d, const uint8_t *bytes, size_t count) {
+    if (d->target->write_be) {
+        d->target->write_be(d->target_ctx, bytes, count);
+        return;
+    }
+    
+    while (count > 0) {
+        size_t n = count < ILI9341_WIDTH ? count : ILI9341_WIDTH;
+        for (size_t i = 0; i < n; i++, bytes += 2) {
+            d->line[i] = ((uint16_t)bytes[0] << 8) | bytes[1];
         }
+        d->target->write(d->target_ctx, d->line, n);
+        count -= n;
+    }
+}
+
+void ili9341_draw_bitmap_be_on(ili9341_display_t *d, int16_t x, int16_t y, uint16_t w, uint16_t h,
+                               const uint8_t *data) {
+    CAPTURE(d, .type = ILI9341_OP_BITMAP_BE, .x = x, .y = y, .w = w, .h = h, .data = data);
+    STAT_PRIMITIVE(d, ILI9341_STAT_BITMAP_BE);
+    
+    clip_t c = clip_current(d);
+    int32_t cx = x, cy = y, cw = w, ch = h;
+    if (!clip_rect(&c, &cx, &cy, &cw, &ch)) return;
+    
+    data += ((uint32_t)(cy - y) * w + (cx - x)) * 2;
+    d->target->window(d->target_ctx, cx, cy, cw, ch);
+    if (cw == w) {
+        target_write_be(d, data, (uint32_t)w * ch);
+    } else {
+        for (int32_t row = 0; row < ch; row++) {
+            target_write_be(d, data + (uint32_t)row * w * 2, cw);
+        }
+    }
+    d->target->end(d->target_ctx);
+}
+
+// Packed bitmaps
+//
+// Opaque masks and indexed bitmaps go out as one window, cut to the clip.
+// Each source row is expanded from the first visible column through a
+// lookup table (the palette, or {bg, color} for a mask) into the line
+// buffer and sent once per visible scaled row. Transparent masks send one
+// span per run of set bits, like transparent text.
+
+// Expand count pixels of a scaled row, starting skip pixels into it
+static void expand_row(uint16_t *dst, uint32_t count, const uint8_t *src, uint8_t bpp,
+                       const uint16_t *lut, uint8_t scale, uint32_t skip) {
+    const uint8_t mask = (1u << bpp) - 1;
+    uint32_t first = skip / scale * bpp;    // Bit offset of the first source pixel
+    uint32_t n = scale - skip % scale;      // Copies of it still visible
+    
+    src += first / 8;
+    uint8_t byte = *src++;
+    int8_t shift = 8 - bpp - first % 8;
+    
+    while (count > 0) {
+        if (shift < 0) {
+            byte = *src++;
+            shift = 8 - bpp;
+        }
+        uint16_t pixel = lut[(byte >> shift) & mask];
+        shift -= bpp;
+        
+        if (n > count) n = count;
+        for (uint32_t k = 0; k < n; k++) *dst++ = pixel;
+        count -= n;
+        n = scale;
+    }
+}
+
+static void blit_packed(const clip_t *c, int32_t x, int32_t y, uint16_t w, uint16_t h,
+                        const uint8_t *data, uint8_t bpp, const uint16_t *lut, uint8_t scale) {
+    int32_t cx = x, cy = y;
+    int32_t cw = (int32_t)w * scale;
+    int32_t ch = (int32_t)h * scale;
+    uint32_t stride = ((uint32_t)w * bpp + 7) / 8;
+    
+    if (!clip_rect(c, &cx, &cy, &cw, &ch)) return;
+    
+    int32_t line = cy - y;
+    int32_t last = line + ch;
+    const ili9341_target_t *t = c->d->target;
+    void *ctx = c->d->target_ctx;
+    uint16_t *buffer = c->d->line;
+    
+    t->window(ctx, cx, cy, cw, ch);
+    while (line < last) {
+        int32_t row = line / scale;
+        int32_t end = (row + 1) * scale;
+        
+        expand_row(buffer, cw, data + row * stride, bpp, lut, scale, cx - x);
+        if (end > last) end = last;
+        for (; line < end; line++) {
+            t->write(ctx, buffer, cw);
+        }
+    }
+    t->end(ctx);
+}
+
+static void mask_transparent(const clip_t *c, int32_t x, int32_t y, uint16_t w, uint16_t h,
+                             const uint8_t *mask, uint16_t color, uint8_t size) {
+    uint32_t stride = ((uint32_t)w + 7) / 8;
+    
+    for (uint16_t row = 0; row < h; row++) {
+        int32_t py = y + (int32_t)row * size;
+        if (py > c->y1) break;
+        if (py + size <= c->y0) continue;
+        
+        const uint8_t *bits = mask + row * stride;
+        for (uint16_t col = 0; col < w; col++) {
+            if (!((bits[col >> 3] << (col & 7)) & 0x80)) continue;
+            
+            uint16_t run = col;
+            while (run + 1 < w && ((bits[(run + 1) >> 3] << ((run + 1) & 7)) & 0x80)) run++;
+            fill_clipped(c, x + (int32_t)col * size, py, (run - col + 1) * size, size, color);
+            col = run;
+        }
+    }
+}
+
+void ili9341_draw_bitmap_mask_on(ili9341_display_t *d, int16_t x, int16_t y, uint16_t w, uint16_t h,
+                                 const uint8_t *mask, uint16_t color, uint16_t bg, uint8_t size) {
+    CAPTURE(d, .type = ILI9341_OP_MASK, .x = x, .y = y, .w = w, .h = h, .data = mask,
+            .color = color, .bg = bg, .size = size);
+    STAT_PRIMITIVE(d, ILI9341_STAT_MASK);
+    
+    if (w == 0 || h == 0 || size == 0) return;
+    
+    clip_t c = clip_current(d);
+    if (clip_misses(&c, x, y, x + (int32_t)w * size - 1, y + (int32_t)h * size - 1)) return;
+    
+    if (bg == color) {
+        mask_transparent(&c, x, y, w, h, mask, color, size);
+    } else {
+        const uint16_t lut[2] = { bg, color };
+        blit_packed(&c, x, y, w, h, mask, 1, lut, size);
+    }
+}
+
+void ili9341_draw_bitmap_indexed_on(ili9341_display_t *d, int16_t x, int16_t y, uint16_t w, uint16_t h,
+                                    uint8_t bpp, const uint8_t *data, const uint16_t *palette) {
+    CAPTURE(d, .type = ILI9341_OP_INDEXED, .x = x, .y = y, .w = w, .h = h, .size = bpp,
+            .data = data, .palette = palette);
+    STAT_PRIMITIVE(d, ILI9341_STAT_INDEXED);
+    
+    if (bpp != 1 && bpp != 2 && bpp != 4 && bpp != 8) return;
+    
+    clip_t c = clip_current(d);
+    blit_packed(&c, x, y, w, h, data, bpp, palette, 1);
+}
+
+// Asynchronous transfers
+
+// Each display has its own queue. Jobs run in order, one at a time; each
+// is started from the completion of the previous one (DMA interrupt on the
+// Pico, worker thread on the host), on the display it was queued for even
+// if another one has been selected since.
+
+static inline uint32_t async_lock(ili9341_display_t *d) {
+    return d->transport->lock ? d->transport->lock(d->transport_ctx) : 0;
+}
+
+static inline void async_unlock(ili9341_display_t *d, uint32_t state) {
+    if (d->transport->unlock) d->transport->unlock(d->transport_ctx, state);
+}
+
+static void async_done(void *arg);
+
+// Called with the lock held, for the job at the head of the ring
+static void async_start(ili9341_display_t *d, ili9341_async_job_t *job) {
+    const ili9341_transport_t *t = d->transport;
+    uint32_t count = (uint32_t)job->w * job->h;
+    
+    t->begin(d->transport_ctx);
+    STAT_ASYNC(d, display_window(d, job->x, job->y, job->x + job->w - 1, job->y + job->h - 1), count);
+    if (job->bytes) {
+        t->start_bytes(d->transport_ctx, job->bytes, count * 2, async_done, d);
+    } else if (job->data) {
+        t->start_pixels(d->transport_ctx, job->data, count, async_done, d);
+    } else {
+        t->start_fill(d->transport_ctx, &job->color, count, async_done, d);
+    }
+}
+
+static void async_done(void *arg) {
+    ili9341_display_t *d = arg;
+    uint32_t state = async_lock(d);
+    
+    ili9341_async_job_t *job = &d->async.jobs[d->async.head];
+    ili9341_async_callback_t callback = job->callback;
+    void *user = job->user;
+    
+    d->transport->end(d->transport_ctx);
+    window_advance(d, (uint32_t)job->w * job->h);
+    
+    d->async.head = (d->async.head + 1) % ILI9341_ASYNC_QUEUE_DEPTH;
+    d->async.count--;
+    if (d->async.count) async_start(d, &d->async.jobs[d->async.head]);
+    async_unlock(d, state);
+    
+    // Run the callback unlocked so it may queue more work
+    if (callback) callback(user);
+    
+    state = async_lock(d);
+    d->async.pending--;
+    async_unlock(d, state);
+}
+
+static void async_submit(ili9341_display_t *d, const ili9341_async_job_t *job) {
+    // Without DMA support in the transport, when rendering into RAM or
+    // while recording, run the job synchronously
+    bool dma = d->transport->start_pixels && d->transport->start_fill &&
+               (!job->bytes || d->transport->start_bytes);
+    if (!dma || !ili9341_target_is_panel_on(d) || d->capture) {
+        if (job->bytes) {
+            ili9341_draw_bitmap_be_on(d, job->x, job->y, job->w, job->h, job->bytes);
+        } else if (job->data) {
+            ili9341_draw_bitmap_on(d, job->x, job->y, job->w, job->h, job->data);
+        } else {
+            ili9341_fill_rect_on(d, job->x, job->y, job->w, job->h, job->color);
+        }
+        if (job->callback) job->callback(job->user);
+        return;
+    }
+    
+    // Back-pressure: wait for a free slot
+    while (d->async.count >= ILI9341_ASYNC_QUEUE_DEPTH) {
+    }
+    if (d->shares_bus) display_claim_bus(d);
+    
+    uint32_t state = async_lock(d);
+    uint8_t slot = (d->async.head + d->async.count) % ILI9341_ASYNC_QUEUE_DEPTH;
+    d->async.jobs[slot] = *job;
+    d->async.count++;
+    d->async.pending++;
+    if (d->async.count == 1) async_start(d, &d->async.jobs[slot]);
+    async_unlock(d, state);
+}
+
+void ili9341_fill_rect_async_on(ili9341_display_t *d, int16_t x, int16_t y, uint16_t w, uint16_t h,
+                                uint16_t color, ili9341_async_callback_t callback, void *user) {
+    STAT_PRIMITIVE(d, ILI9341_STAT_ASYNC);
+    ili9341_async_job_t job = { .color = color, .callback = callback, .user = user };
+    
+    // Same clipping as ili9341_fill_rect; an empty fill still calls back
+    clip_t c = clip_current(d);
+    int32_t cx = x, cy = y, cw = w, ch = h;
+    if (!clip_rect(&c, &cx, &cy, &cw, &ch)) {
+        if (callback) callback(user);
+        return;
     }
+    
+    job.x = cx;
+    job.y = cy;
+    job.w = cw;
+    job.h = ch;
+    async_submit(d, &job);
+}
+
+typedef enum {
+    VISIBLE_NONE,
+    VISIBLE_PART,
+    VISIBLE_ALL,
+} visible_t;
+
+static visible_t clip_visible(ili9341_display_t *d, int16_t x, int16_t y, uint16_t w, uint16_t h) {
+    clip_t c = clip_current(d);
+    int32_t cx = x, cy = y, cw = w, ch = h;
+    
+    if (!clip_rect(&c, &cx, &cy, &cw, &ch)) return VISIBLE_NONE;
+    return (cw == w && ch == h) ? VISIBLE_ALL : VISIBLE_PART;
 }
 
-void ili9341_draw_string(uint16_t x, uint16_t y, const char *str, uint16_t color, uint16_t bg, uint8_t size) {
-    while (*str) {
-        ili9341_draw_char(x, y, *str++, color, bg, size);
-        x += 6 * size;
+void ili9341_draw_bitmap_async_on(ili9341_display_t *d, int16_t x, int16_t y, uint16_t w, uint16_t h,
+                                  const uint16_t *data, ili9341_async_callback_t callback, void *user) {
+    STAT_PRIMITIVE(d, ILI9341_STAT_ASYNC);
+    ili9341_async_job_t job = { .x = x, .y = y, .w = w, .h = h, .data = data,
+                        .callback = callback, .user = user };
+    
+    switch (clip_visible(d, x, y, w, h)) {
+        case VISIBLE_ALL:
+            async_submit(d, &job);
+            return;
+        case VISIBLE_PART:
+            // Partly clipped bitmaps need per-row clipping, draw them blocking
+            ili9341_draw_bitmap_on(d, x, y, w, h, data);
+            break;
+        case VISIBLE_NONE:
+            break;
     }
+    if (callback) callback(user);
 }
 
-void ili9341_draw_bitmap(uint16_t x, uint16_t y, uint16_t w, uint16_t h, const uint16_t *data) {
-    ili9341_set_window(x, y, x + w - 1, y + h - 1);
+void ili9341_draw_bitmap_be_async_on(ili9341_display_t *d, int16_t x, int16_t y, uint16_t w, uint16_t h,
+                                     const uint8_t *data, ili9341_async_callback_t callback, void *user) {
+    STAT_PRIMITIVE(d, ILI9341_STAT_ASYNC);
+    ili9341_async_job_t job = { .x = x, .y = y, .w = w, .h = h, .bytes = data,
+                        .callback = callback, .user = user };
     
-    dc_data();
-    cs_select();
-    for (uint32_t i = 0; i < w * h; i++) {
-        uint8_t buffer[2];
-        buffer[0] = data[i] >> 8;
-        buffer[1] = data[i] & 0xFF;
-        spi_write_blocking(g_display_config->spi_port, buffer, 2);
+    switch (clip_visible(d, x, y, w, h)) {
+        case VISIBLE_ALL:
+            async_submit(d, &job);
+            return;
+        case VISIBLE_PART:
+            ili9341_draw_bitmap_be_on(d, x, y, w, h, data);
+            break;
+        case VISIBLE_NONE:
+            break;
     }
-    cs_deselect();
+    if (callback) callback(user);
+}
+
+bool ili9341_async_busy_on(const ili9341_display_t *d) {
+    return d->async.pending != 0;
+}
+
+void ili9341_async_wait_on(ili9341_display_t *d) {
+    display_async_wait(d);
+}
+
+// The calls on the selected display
+
+void ili9341_reset(void) {
+    ili9341_reset_on(g_display);
+}
+
+void ili9341_write_command(uint8_t cmd) {
+    ili9341_write_command_on(g_display, cmd);
+}
+
+void ili9341_write_data(uint8_t data) {
+    ili9341_write_data_on(g_display, data);
+}
+
+void ili9341_write_data16(uint16_t data) {
+    ili9341_write_data16_on(g_display, data);
+}
+
+void ili9341_write_command_data(uint8_t cmd, const uint8_t *params, size_t len) {
+    ili9341_write_command_data_on(g_display, cmd, params, len);
+}
+
+void ili9341_write_command_stream(const uint8_t *stream, size_t len) {
+    ili9341_write_command_stream_on(g_display, stream, len);
+}
+
+void ili9341_set_rotation(uint8_t rotation) {
+    ili9341_set_rotation_on(g_display, rotation);
+}
+
+uint8_t ili9341_get_rotation(void) {
+    return ili9341_get_rotation_on(g_display);
+}
+
+uint16_t ili9341_width(void) {
+    return ili9341_width_on(g_display);
+}
+
+uint16_t ili9341_height(void) {
+    return ili9341_height_on(g_display);
+}
+
+bool ili9341_set_window(int16_t x0, int16_t y0, int16_t x1, int16_t y1) {
+    return ili9341_set_window_on(g_display, x0, y0, x1, y1);
+}
+
+void ili9341_fill_screen(uint16_t color) {
+    ili9341_fill_screen_on(g_display, color);
+}
+
+void ili9341_scroll_define(uint16_t top_fixed, uint16_t bottom_fixed) {
+    ili9341_scroll_define_on(g_display, top_fixed, bottom_fixed);
+}
+
+void ili9341_scroll_set(uint16_t offset) {
+    ili9341_scroll_set_on(g_display, offset);
+}
+
+void ili9341_scroll(int16_t lines) {
+    ili9341_scroll_on(g_display, lines);
+}
+
+uint16_t ili9341_scroll_offset(void) {
+    return ili9341_scroll_offset_on(g_display);
+}
+
+uint16_t ili9341_scroll_y(uint16_t y) {
+    return ili9341_scroll_y_on(g_display, y);
+}
+
+bool ili9341_clip_push(int16_t x, int16_t y, uint16_t w, uint16_t h) {
+    return ili9341_clip_push_on(g_display, x, y, w, h);
+}
+
+void ili9341_clip_pop(void) {
+    ili9341_clip_pop_on(g_display);
+}
+
+void ili9341_clip_reset(void) {
+    ili9341_clip_reset_on(g_display);
+}
+
+bool ili9341_clip_get(ili9341_span_t *clip) {
+    return ili9341_clip_get_on(g_display, clip);
+}
+
+void ili9341_draw_pixel(int16_t x, int16_t y, uint16_t color) {
+    ili9341_draw_pixel_on(g_display, x, y, color);
+}
+
+void ili9341_draw_line(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) {
+    ili9341_draw_line_on(g_display, x0, y0, x1, y1, color);
+}
+
+void ili9341_draw_rect(int16_t x, int16_t y, uint16_t w, uint16_t h, uint16_t color) {
+    ili9341_draw_rect_on(g_display, x, y, w, h, color);
+}
+
+void ili9341_fill_rect(int16_t x, int16_t y, uint16_t w, uint16_t h, uint16_t color) {
+    ili9341_fill_rect_on(g_display, x, y, w, h, color);
+}
+
+void ili9341_draw_circle(int16_t x0, int16_t y0, uint16_t r, uint16_t color) {
+    ili9341_draw_circle_on(g_display, x0, y0, r, color);
+}
+
+void ili9341_fill_circle(int16_t x0, int16_t y0, uint16_t r, uint16_t color) {
+    ili9341_fill_circle_on(g_display, x0, y0, r, color);
+}
+
+void ili9341_fill_ellipse(int16_t x0, int16_t y0, uint16_t rx, uint16_t ry, uint16_t color) {
+    ili9341_fill_ellipse_on(g_display, x0, y0, rx, ry, color);
+}
+
+void ili9341_fill_ring(int16_t x0, int16_t y0, uint16_t r_outer, uint16_t r_inner, uint16_t color) {
+    ili9341_fill_ring_on(g_display, x0, y0, r_outer, r_inner, color);
+}
+
+void ili9341_fill_sector(int16_t x0, int16_t y0, uint16_t r_outer, uint16_t r_inner,
+                         int32_t start_angle, int32_t end_angle, uint16_t color) {
+    ili9341_fill_sector_on(g_display, x0, y0, r_outer, r_inner, start_angle, end_angle, color);
+}
+
+void ili9341_fill_spans(const ili9341_span_t *spans, size_t count, uint16_t color) {
+    ili9341_fill_spans_on(g_display, spans, count, color);
+}
+
+void ili9341_draw_char(int16_t x, int16_t y, char c, uint16_t color, uint16_t bg, uint8_t size) {
+    ili9341_draw_char_on(g_display, x, y, c, color, bg, size);
+}
+
+void ili9341_draw_string(int16_t x, int16_t y, const char *str, uint16_t color, uint16_t bg, uint8_t size) {
+    ili9341_draw_string_on(g_display, x, y, str, color, bg, size);
+}
+
+void ili9341_draw_bitmap(int16_t x, int16_t y, uint16_t w, uint16_t h, const uint16_t *data) {
+    ili9341_draw_bitmap_on(g_display, x, y, w, h, data);
+}
+
+void ili9341_draw_bitmap_be(int16_t x, int16_t y, uint16_t w, uint16_t h, const uint8_t *data) {
+    ili9341_draw_bitmap_be_on(g_display, x, y, w, h, data);
+}
+
+void ili9341_draw_bitmap_mask(int16_t x, int16_t y, uint16_t w, uint16_t h, const uint8_t *mask,
+                              uint16_t color, uint16_t bg, uint8_t size) {
+    ili9341_draw_bitmap_mask_on(g_display, x, y, w, h, mask, color, bg, size);
+}
+
+void ili9341_draw_bitmap_indexed(int16_t x, int16_t y, uint16_t w, uint16_t h, uint8_t bpp,
+                                 const uint8_t *data, const uint16_t *palette) {
+    ili9341_draw_bitmap_indexed_on(g_display, x, y, w, h, bpp, data, palette);
+}
+
+void ili9341_fill_rect_async(int16_t x, int16_t y, uint16_t w, uint16_t h, uint16_t color,
+                             ili9341_async_callback_t callback, void *user) {
+    ili9341_fill_rect_async_on(g_display, x, y, w, h, color, callback, user);
+}
+
+void ili9341_draw_bitmap_async(int16_t x, int16_t y, uint16_t w, uint16_t h, const uint16_t *data,
+                               ili9341_async_callback_t callback, void *user) {
+    ili9341_draw_bitmap_async_on(g_display, x, y, w, h, data, callback, user);
+}
+
+void ili9341_draw_bitmap_be_async(int16_t x, int16_t y, uint16_t w, uint16_t h, const uint8_t *data,
+                                  ili9341_async_callback_t callback, void *user) {
+    ili9341_draw_bitmap_be_async_on(g_display, x, y, w, h, data, callback, user);
+}
+
+bool ili9341_async_busy(void) {
+    return ili9341_async_busy_on(g_display);
+}
+
+void ili9341_async_wait(void) {
+    ili9341_async_wait_on(g_display);
+}
+
+void ili9341_set_target(const ili9341_target_t *target, void *ctx) {
+    ili9341_set_target_on(g_display, target, ctx);
+}
+
+bool ili9341_target_is_panel(void) {
+    return ili9341_target_is_panel_on(g_display);
+}
+
+void ili9341_set_capture(ili9341_capture_t capture, void *ctx) {
+    ili9341_set_capture_on(g_display, capture, ctx);
+}
+
+bool ili9341_capture(const ili9341_op_t *op) {
+    return ili9341_capture_on(g_display, op);
+}
+
+void ili9341_op_draw(const ili9341_op_t *op) {
+    ili9341_op_draw_on(g_display, op);
 }
 
 uint16_t ili9341_color565(uint8_t r, uint8_t g, uint8_t b) {
     return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3);
 }
+
+#ifdef ILI9341_STATS
+static void stats_add(ili9341_stats_entry_t *to, const ili9341_stats_entry_t *from) {
+    to->calls += from->calls;
+    to->transactions += from->transactions;
+    to->dc_toggles += from->dc_toggles;
+    to->windows += from->windows;
+    to->bytes += from->bytes;
+    to->pixels += from->pixels;
+    to->time_us += from->time_us;
+}
+
+// Each display counts its primitives; transfer counters are written from
+// completion context, so those are read and cleared under its lock
+void ili9341_stats_snapshot(ili9341_stats_t *out) {
+    memset(out, 0, sizeof(*out));
+    for (ili9341_display_t *d = g_displays; d; d = d->next) {
+        for (int i = 0; i < ILI9341_STAT_COUNT; i++) {
+            stats_add(&out->primitive[i], &d->stats.counters.primitive[i]);
+        }
+        
+        uint32_t state = async_lock(d);
+        stats_add(&out->primitive[ILI9341_STAT_ASYNC], &d->async.stats);
+        async_unlock(d, state);
+    }
+}
+
+void ili9341_stats_reset(void) {
+    for (ili9341_display_t *d = g_displays; d; d = d->next) {
+        memset(&d->stats.counters, 0, sizeof(d->stats.counters));
+        
+        uint32_t state = async_lock(d);
+        memset(&d->async.stats, 0, sizeof(d->async.stats));
+        async_unlock(d, state);
+    }
+}
+
+void ili9341_stats_print(const ili9341_stats_t *stats) {
+    static const char *const names[ILI9341_STAT_COUNT] = {
+        "pixel", "line", "rect", "fill_rect", "circle", "fill_circle",
+        "fill_ellipse", "fill_ring", "fill_sector", "fill_spans", "char",
+        "string", "bitmap", "bitmap_be", "mask", "indexed", "async",
+        "command", "other",
+    };
+    ili9341_stats_entry_t total = { 0 };
+    
+    printf("%-12s %8s %10s %8s %8s %8s %10s %10s\n", "primitive", "calls",
+           "bytes", "trans", "dc", "windows", "pixels", "us");
+    for (int i = 0; i < ILI9341_STAT_COUNT; i++) {
+        const ili9341_stats_entry_t *e = &stats->primitive[i];
+        if (!e->calls && !e->bytes) continue;
+        
+        printf("%-12s %8lu %10llu %8lu %8lu %8lu %10llu %10llu\n", names[i],
+               (unsigned long)e->calls, (unsigned long long)e->bytes,
+               (unsigned long)e->transactions, (unsigned long)e->dc_toggles,
+               (unsigned long)e->windows, (unsigned long long)e->pixels,
+               (unsigned long long)e->time_us);
+        stats_add(&total, e);
+    }
+    printf("%-12s %8lu %10llu %8lu %8lu %8lu %10llu %10llu\n", "total",
+           (unsigned long)total.calls, (unsigned long long)total.bytes,
+           (unsigned long)total.transactions, (unsigned long)total.dc_toggles,
+           (unsigned long)total.windows, (unsigned long long)total.pixels,
+           (unsigned long long)total.time_us);
+}
+#endif
@@ -1,8 +1,19 @@
 #ifndef ILI9341_H
 #define ILI9341_H
 
+#ifdef ILI9341_HOST
+// Host builds (benchmarks, regression runs) have no Pico SDK
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+typedef unsigned int uint;
+typedef struct spi_inst spi_inst_t;
+#else
 #include "pico/stdlib.h"
 #include "hardware/spi.h"
+#endif
+
+#include "ili9341_transport.h"
 
 // ILI9341 Commands
 #define ILI9341_NOP        0x00
@@ -13,13 +24,25 @@
 #define ILI9341_CASET      0x2A
 #define ILI9341_PASET      0x2B
 #define ILI9341_RAMWR      0x2C
+#define ILI9341_VSCRDEF    0x33
 #define ILI9341_MADCTL     0x36
+#define ILI9341_VSCRSADD   0x37
 #define ILI9341_PIXFMT     0x3A
 
-// Screen dimensions
+// MADCTL bits
+#define ILI9341_MADCTL_MY  0x80     // Row address order
+#define ILI9341_MADCTL_MX  0x40     // Column address order
+#define ILI9341_MADCTL_MV  0x20     // Row/column exchange
+#define ILI9341_MADCTL_BGR 0x08
+
+// Screen dimensions in ILI9341_ROTATION_0; ili9341_width() and
+// ili9341_height() give them in the current rotation
 #define ILI9341_WIDTH  320
 #define ILI9341_HEIGHT 240
 
+// Widest screen the driver draws on: a canvas of two panels side by side
+#define ILI9341_MAX_WIDTH (2 * ILI9341_WIDTH)
+
 // Color definitions (RGB565)
 #define BLACK       0x0000
 #define BLUE        0x001F
@@ -39,6 +62,10 @@ typedef struct {
     uint mosi_pin;
     uint sck_pin;
     uint baudrate;
+
+    // Optional bus backend, NULL selects the Pico SPI transport
+    const ili9341_transport_t *transport;
+    void *transport_ctx;                    // NULL passes the config itself
 } ili9341_config_t;
 
 // Display rotation
@@ -58,30 +85,478 @@ void ili9341_write_command(uint8_t cmd);
 void ili9341_write_data(uint8_t data);
 void ili9341_write_data16(uint16_t data);
 
+// Command streams: each call is a single CS assertion, DC only switches
+// between the command byte and its parameters. A stream is a packed table
+// of { command, parameter count, parameters... } entries.
+void ili9341_write_command_data(uint8_t cmd, const uint8_t *params, size_t len);
+void ili9341_write_command_stream(const uint8_t *stream, size_t len);
+
 // Display control
-void ili9341_set_rotation(uint8_t rotation);
-void ili9341_set_window(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1);
-void ili9341_fill_screen(uint16_t color);
+// Rotation reprograms MADCTL, so the controller maps coordinates and every
+// primitive still streams rows in GRAM order at full speed. The width and
+// height that clipping uses follow the rotation; 90 and 270 are 240x320.
+// GRAM keeps its contents, which show turned by the change; redraw after
+// rotating. Changes go straight to the panel, so set the rotation before
+// a framebuffer or strip render begins.
+void ili9341_set_rotation(uint8_t rotation);    // ili9341_rotation_t, taken mod 4
+uint8_t ili9341_get_rotation(void);
+uint16_t ili9341_width(void);
+uint16_t ili9341_height(void);
+// Raw address window, clamped to the screen. Returns false, sending
+// nothing, if none of it is on screen.
+bool ili9341_set_window(int16_t x0, int16_t y0, int16_t x1, int16_t y1);
+void ili9341_fill_screen(uint16_t color);       // Fills the clip rectangle
+
+// Hardware vertical scrolling
+// The rows between a fixed top and bottom area form a ring that the panel
+// can show starting at any row, so scrolling costs one command instead of
+// a repaint. Drawing still addresses GRAM: ili9341_scroll_y() turns a row
+// on screen into the GRAM row to draw, so after ili9341_scroll(1) the new
+// bottom line is filled at ili9341_scroll_y(bottom row). Something drawn
+// across the end of the ring must be split there. Scroll commands go
+// straight to the panel, so flush a framebuffer first.
+//
+// Scrolling is fixed to the panel, not to the rotation: rows here are the
+// rows of ILI9341_ROTATION_0 (ILI9341_HEIGHT of them). In rotation 180
+// they run bottom to top, and in 90 and 270 the ring moves along x, with
+// row r being column r (90) or ILI9341_HEIGHT - 1 - r (270).
+// tests/scroll_test.c checks this on the host transport.
+void ili9341_scroll_define(uint16_t top_fixed, uint16_t bottom_fixed);  // Also resets the offset
+void ili9341_scroll_set(uint16_t offset);    // Ring row shown first, 0 = unscrolled
+void ili9341_scroll(int16_t lines);          // Positive moves the content up
+uint16_t ili9341_scroll_offset(void);
+uint16_t ili9341_scroll_y(uint16_t y);       // Fixed rows map to themselves
+
+// Rectangle with a signed origin: a span of a shape, or a clip rectangle
+typedef struct {
+    int16_t x, y;           // Top-left, may lie off-screen
+    uint16_t w, h;
+} ili9341_span_t;
+
+// Clipping
+// Coordinates are signed, and shapes may lie partly or wholly off-screen.
+// Every primitive draws only inside the clip rectangle, which is the screen
+// until one is pushed. A push intersects the new rectangle with the current
+// one, so whatever is drawn inside cannot spill out of it, and a pop
+// restores the previous one. Primitives clip their windows and spans up
+// front, so what falls outside costs no bus traffic. Each display has its
+// own stack, and ili9341_set_rotation() empties it. Display lists
+// store the clip with each op and replay it.
+#ifndef ILI9341_CLIP_DEPTH
+#define ILI9341_CLIP_DEPTH 8
+#endif
+
+bool ili9341_clip_push(int16_t x, int16_t y, uint16_t w, uint16_t h);  // False, pushing nothing, when full
+void ili9341_clip_pop(void);
+void ili9341_clip_reset(void);              // Back to the whole screen
+// Stores the current clip rectangle, cut to the screen (w or h is 0 if
+// nothing is visible); returns false when nothing is pushed
+bool ili9341_clip_get(ili9341_span_t *clip);
 
 // Drawing primitives
-void ili9341_draw_pixel(uint16_t x, uint16_t y, uint16_t color);
-void ili9341_draw_line(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uint16_t color);
-void ili9341_draw_rect(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color);
-void ili9341_fill_rect(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color);
-void ili9341_draw_circle(uint16_t x0, uint16_t y0, uint16_t r, uint16_t color);
-void ili9341_fill_circle(uint16_t x0, uint16_t y0, uint16_t r, uint16_t color);
+void ili9341_draw_pixel(int16_t x, int16_t y, uint16_t color);
+void ili9341_draw_line(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color);
+void ili9341_draw_rect(int16_t x, int16_t y, uint16_t w, uint16_t h, uint16_t color);
+void ili9341_fill_rect(int16_t x, int16_t y, uint16_t w, uint16_t h, uint16_t color);
+void ili9341_draw_circle(int16_t x0, int16_t y0, uint16_t r, uint16_t color);
+void ili9341_fill_circle(int16_t x0, int16_t y0, uint16_t r, uint16_t color);
+void ili9341_fill_ellipse(int16_t x0, int16_t y0, uint16_t rx, uint16_t ry, uint16_t color);
+void ili9341_fill_ring(int16_t x0, int16_t y0, uint16_t r_outer, uint16_t r_inner, uint16_t color);  // Hole is the filled circle of r_inner
+
+// Annular sectors: the pixels of fill_ring() between two rays, clockwise
+// from start_angle to end_angle (pixels on either ray included). Angles are
+// ili9341_math.h units, 1/65536 turn from 3 o'clock; ILI9341_DEG()
+// converts. r_outer is at most 255; a larger radius, r_inner >= r_outer
+// or end_angle < start_angle draws nothing. Shapes redrawn often can be
+// reduced to spans once with ili9341_sector_spans() and filled from the
+// table, one window per span, with ili9341_fill_spans().
+void ili9341_fill_sector(int16_t x0, int16_t y0, uint16_t r_outer, uint16_t r_inner,
+                         int32_t start_angle, int32_t end_angle, uint16_t color);
+// Returns the number of spans in the sector; only the first max are stored
+size_t ili9341_sector_spans(int16_t x0, int16_t y0, uint16_t r_outer, uint16_t r_inner,
+                            int32_t start_angle, int32_t end_angle, ili9341_span_t *spans, size_t max);
+void ili9341_fill_spans(const ili9341_span_t *spans, size_t count, uint16_t color);
 
 // Text rendering
-void ili9341_draw_char(uint16_t x, uint16_t y, char c, uint16_t color, uint16_t bg, uint8_t size);
-void ili9341_draw_string(uint16_t x, uint16_t y, const char *str, uint16_t color, uint16_t bg, uint8_t size);
+void ili9341_draw_char(int16_t x, int16_t y, char c, uint16_t color, uint16_t bg, uint8_t size);
+void ili9341_draw_string(int16_t x, int16_t y, const char *str, uint16_t color, uint16_t bg, uint8_t size);
 
 // Image rendering
-void ili9341_draw_bitmap(uint16_t x, uint16_t y, uint16_t w, uint16_t h, const uint16_t *data);
+void ili9341_draw_bitmap(int16_t x, int16_t y, uint16_t w, uint16_t h, const uint16_t *data);
+
+// Panel-native bitmaps: RGB565 stored big-endian, two bytes per pixel, as
+// produced by image_converter.py --native or --native-bytes. The bytes are
+// handed to the bus unchanged, whole or one row slice at a time when the
+// image is clipped.
+void ili9341_draw_bitmap_be(int16_t x, int16_t y, uint16_t w, uint16_t h, const uint8_t *data);
+
+// Packed bitmaps: pixels at bpp bits each, most significant bits first,
+// every row starting on a byte boundary. Masks are 1 bpp, drawn in color
+// where set and bg where clear (transparent where clear if bg == color),
+// scaled by an integer size like text. Indexed bitmaps are 1, 2, 4 or 8
+// bpp, each value an index into the palette; image_converter.py --indexed
+// produces both arrays.
+void ili9341_draw_bitmap_mask(int16_t x, int16_t y, uint16_t w, uint16_t h, const uint8_t *mask,
+                              uint16_t color, uint16_t bg, uint8_t size);
+void ili9341_draw_bitmap_indexed(int16_t x, int16_t y, uint16_t w, uint16_t h, uint8_t bpp,
+                                 const uint8_t *data, const uint16_t *palette);
+
+// Asynchronous transfers
+// Queue the transfer on the transport's DMA engine and return immediately.
+// Bitmap data must stay valid until the callback runs. Callbacks run in
+// interrupt (Pico) or worker-thread (host) context, in submission order,
+// and may queue more transfers but must not draw synchronously. Any
+// blocking call waits for the queue to drain first. Transfers are clipped
+// when they are queued; a bitmap only part of which is inside the clip
+// is drawn blocking before the call returns.
+typedef void (*ili9341_async_callback_t)(void *user);
+
+void ili9341_fill_rect_async(int16_t x, int16_t y, uint16_t w, uint16_t h, uint16_t color,
+                             ili9341_async_callback_t callback, void *user);
+void ili9341_draw_bitmap_async(int16_t x, int16_t y, uint16_t w, uint16_t h, const uint16_t *data,
+                               ili9341_async_callback_t callback, void *user);
+void ili9341_draw_bitmap_be_async(int16_t x, int16_t y, uint16_t w, uint16_t h, const uint8_t *data,
+                                  ili9341_async_callback_t callback, void *user);
+bool ili9341_async_busy(void);
+void ili9341_async_wait(void);
+
+// Displays
+//
+// Each panel has its own ili9341_display_t: transport, window cache,
+// rotation, scroll state, clip stack, render target, capture hook and
+// asynchronous queue. Every call above draws on the selected display, and
+// ili9341_display_select() switches panels without touching the bus. The
+// _on variants below take the display instead and leave the selection
+// alone, so core1 can draw on one panel while core0 draws on another, and
+// a helper can draw on whatever panel it is handed. One display is drawn
+// from one core at a time. A display's queued transfers keep running
+// after another one is selected, so panels on different SPI instances
+// stream at the same time. Panels sharing an SPI instance through
+// separate CS pins take turns: drawing on one waits for the other's queue,
+// so they belong to the same core.
+//
+//     static ili9341_display_t left, right;
+//     ili9341_display_init(&left, &left_config);      // spi0
+//     ili9341_display_init(&right, &right_config);    // spi1
+//     ili9341_display_select(&left);
+//     ili9341_draw_bitmap_async(...);                 // Keeps streaming...
+//     ili9341_fill_screen_on(&right, BLACK);          // ...while this runs
+//
+// ili9341_init() initializes and selects a built-in display, which is all
+// a single-panel program needs. Framebuffers, strips, display lists and
+// compressed images work on the selected display; keep it selected from
+// their begin to their end. A framebuffer flushes to whichever display is
+// selected when ili9341_flush() runs.
+#ifndef ILI9341_ASYNC_QUEUE_DEPTH
+#define ILI9341_ASYNC_QUEUE_DEPTH 8
+#endif
+
+// Circle half-width tables kept per display for recently used radii
+#ifndef ILI9341_SPAN_CACHE_SLOTS
+#define ILI9341_SPAN_CACHE_SLOTS 4
+#endif
+#ifndef ILI9341_SPAN_CACHE_RADIUS
+#define ILI9341_SPAN_CACHE_RADIUS 120       // Largest cached radius
+#endif
+
+typedef struct {
+    uint16_t x, y, w, h;
+    const uint16_t *data;               // NULL for fills
+    const uint8_t *bytes;               // Panel-native bitmap instead
+    uint16_t color;                     // Fill source word, re-read by the DMA
+    ili9341_async_callback_t callback;
+    void *user;
+} ili9341_async_job_t;
+
+typedef struct {
+    bool valid;
+    uint8_t radius;
+    uint32_t last_used;
+    uint8_t half[ILI9341_SPAN_CACHE_RADIUS + 1];    // Half-width of each row
+} ili9341_span_table_t;
+
+#ifdef ILI9341_STATS
+// Counters for one primitive, see Instrumentation below
+typedef struct {
+    uint32_t calls;
+    uint32_t transactions;      // CS assertions
+    uint32_t dc_toggles;
+    uint32_t windows;           // Address windows requested, cached or not
+    uint64_t bytes;
+    uint64_t pixels;
+    uint64_t time_us;
+} ili9341_stats_entry_t;
+
+typedef enum {
+    ILI9341_STAT_PIXEL = 0,
+    ILI9341_STAT_LINE,
+    ILI9341_STAT_RECT,
+    ILI9341_STAT_FILL_RECT,
+    ILI9341_STAT_CIRCLE,
+    ILI9341_STAT_FILL_CIRCLE,
+    ILI9341_STAT_FILL_ELLIPSE,
+    ILI9341_STAT_FILL_RING,
+    ILI9341_STAT_FILL_SECTOR,
+    ILI9341_STAT_FILL_SPANS,
+    ILI9341_STAT_CHAR,
+    ILI9341_STAT_STRING,
+    ILI9341_STAT_BITMAP,
+    ILI9341_STAT_BITMAP_BE,
+    ILI9341_STAT_MASK,
+    ILI9341_STAT_INDEXED,
+    ILI9341_STAT_ASYNC,         // *_async calls and the transfers they queue
+    ILI9341_STAT_COMMAND,       // Raw commands, set_window, rotation, scrolling
+    ILI9341_STAT_OTHER,         // Traffic outside any primitive
+    ILI9341_STAT_COUNT
+} ili9341_stat_t;
+
+typedef struct {
+    ili9341_stats_entry_t primitive[ILI9341_STAT_COUNT];
+} ili9341_stats_t;
+#endif
+
+struct ili9341_target;
+struct ili9341_op;
+typedef void (*ili9341_capture_t)(void *ctx, const struct ili9341_op *op);
+
+typedef struct ili9341_display {
+    ili9341_config_t *config;
+    const ili9341_transport_t *transport;
+    void *transport_ctx;
+    struct ili9341_display *next;       // Initialized displays
+    bool shares_bus;                    // Another display uses the same SPI instance
+
+    uint16_t native_width;              // Size in ILI9341_ROTATION_0
+    uint16_t native_height;
+    uint16_t width, height;             // Size in the current rotation
+    uint8_t rotation;
+
+    // Address window the controller holds and where the next pixel lands
+    struct {
+        bool valid;                     // x0..y1 match the controller
+        bool ram_write;                 // RAMWR active, data continues at cx/cy
+        uint16_t x0, y0, x1, y1;
+        uint16_t cx, cy;
+        uint32_t streamed;              // Pixels sent into the window the panel target opened
+    } window;
+
+    // Clip rectangles, inclusive, each inside the one below it. The screen
+    // edges are applied when drawing rather than stored here.
+    struct {
+        struct {
+            int16_t x0, y0, x1, y1;
+        } stack[ILI9341_CLIP_DEPTH];
+        uint8_t depth;
+    } clip;
+
+    // Hardware scroll, as set by the last VSCRDEF/VSCRSADD
+    struct {
+        uint16_t top;                   // Fixed rows above the ring
+        uint16_t area;                  // Rows in the ring
+        uint16_t offset;                // Ring row shown at its top
+    } scroll;
+
+    // Where primitives render, and the hook recording them instead
+    const struct ili9341_target *target;
+    void *target_ctx;
+    ili9341_capture_t capture;
+    void *capture_ctx;
+
+    // Scratch for the rasterizers: one row of pixels for blitters that
+    // expand or convert their source, and the circle tables
+    uint16_t line[ILI9341_MAX_WIDTH];
+    struct {
+        ili9341_span_table_t table[ILI9341_SPAN_CACHE_SLOTS];
+        uint32_t clock;
+    } spans;
+
+    // Asynchronous transfer ring, drained by completion callbacks
+    struct {
+        ili9341_async_job_t jobs[ILI9341_ASYNC_QUEUE_DEPTH];
+        volatile uint8_t head;
+        volatile uint8_t count;         // Jobs in the ring
+        volatile uint8_t pending;       // Jobs whose callback has not returned
+#ifdef ILI9341_STATS
+        ili9341_stats_entry_t stats;    // Transfers started, only touched under the lock
+#endif
+    } async;
+
+#ifdef ILI9341_STATS
+    // Primitives drawn on this display, see Instrumentation below
+    struct {
+        uint8_t current;                // Primitive being counted, 0xFF for none
+        ili9341_stats_t counters;
+    } stats;
+#endif
+} ili9341_display_t;
+
+// Bring up a panel as ili9341_init() does and select it
+void ili9341_display_init(ili9341_display_t *display, ili9341_config_t *config);
+void ili9341_display_select(ili9341_display_t *display);
+ili9341_display_t *ili9341_display_current(void);
+
+// The calls above on a given display
+void ili9341_reset_on(ili9341_display_t *d);
+void ili9341_write_command_on(ili9341_display_t *d, uint8_t cmd);
+void ili9341_write_data_on(ili9341_display_t *d, uint8_t data);
+void ili9341_write_data16_on(ili9341_display_t *d, uint16_t data);
+void ili9341_write_command_data_on(ili9341_display_t *d, uint8_t cmd, const uint8_t *params, size_t len);
+void ili9341_write_command_stream_on(ili9341_display_t *d, const uint8_t *stream, size_t len);
+
+void ili9341_set_rotation_on(ili9341_display_t *d, uint8_t rotation);
+uint8_t ili9341_get_rotation_on(const ili9341_display_t *d);
+uint16_t ili9341_width_on(const ili9341_display_t *d);
+uint16_t ili9341_height_on(const ili9341_display_t *d);
+bool ili9341_set_window_on(ili9341_display_t *d, int16_t x0, int16_t y0, int16_t x1, int16_t y1);
+void ili9341_fill_screen_on(ili9341_display_t *d, uint16_t color);
+
+void ili9341_scroll_define_on(ili9341_display_t *d, uint16_t top_fixed, uint16_t bottom_fixed);
+void ili9341_scroll_set_on(ili9341_display_t *d, uint16_t offset);
+void ili9341_scroll_on(ili9341_display_t *d, int16_t lines);
+uint16_t ili9341_scroll_offset_on(const ili9341_display_t *d);
+uint16_t ili9341_scroll_y_on(const ili9341_display_t *d, uint16_t y);
+
+bool ili9341_clip_push_on(ili9341_display_t *d, int16_t x, int16_t y, uint16_t w, uint16_t h);
+void ili9341_clip_pop_on(ili9341_display_t *d);
+void ili9341_clip_reset_on(ili9341_display_t *d);
+bool ili9341_clip_get_on(ili9341_display_t *d, ili9341_span_t *clip);
+
+void ili9341_draw_pixel_on(ili9341_display_t *d, int16_t x, int16_t y, uint16_t color);
+void ili9341_draw_line_on(ili9341_display_t *d, int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color);
+void ili9341_draw_rect_on(ili9341_display_t *d, int16_t x, int16_t y, uint16_t w, uint16_t h, uint16_t color);
+void ili9341_fill_rect_on(ili9341_display_t *d, int16_t x, int16_t y, uint16_t w, uint16_t h, uint16_t color);
+void ili9341_draw_circle_on(ili9341_display_t *d, int16_t x0, int16_t y0, uint16_t r, uint16_t color);
+void ili9341_fill_circle_on(ili9341_display_t *d, int16_t x0, int16_t y0, uint16_t r, uint16_t color);
+void ili9341_fill_ellipse_on(ili9341_display_t *d, int16_t x0, int16_t y0, uint16_t rx, uint16_t ry,
+                             uint16_t color);
+void ili9341_fill_ring_on(ili9341_display_t *d, int16_t x0, int16_t y0, uint16_t r_outer, uint16_t r_inner,
+                          uint16_t color);
+void ili9341_fill_sector_on(ili9341_display_t *d, int16_t x0, int16_t y0, uint16_t r_outer, uint16_t r_inner,
+                            int32_t start_angle, int32_t end_angle, uint16_t color);
+void ili9341_fill_spans_on(ili9341_display_t *d, const ili9341_span_t *spans, size_t count, uint16_t color);
+void ili9341_draw_char_on(ili9341_display_t *d, int16_t x, int16_t y, char c, uint16_t color, uint16_t bg,
+                          uint8_t size);
+void ili9341_draw_string_on(ili9341_display_t *d, int16_t x, int16_t y, const char *str, uint16_t color,
+                            uint16_t bg, uint8_t size);
+void ili9341_draw_bitmap_on(ili9341_display_t *d, int16_t x, int16_t y, uint16_t w, uint16_t h,
+                            const uint16_t *data);
+void ili9341_draw_bitmap_be_on(ili9341_display_t *d, int16_t x, int16_t y, uint16_t w, uint16_t h,
+                               const uint8_t *data);
+void ili9341_draw_bitmap_mask_on(ili9341_display_t *d, int16_t x, int16_t y, uint16_t w, uint16_t h,
+                                 const uint8_t *mask, uint16_t color, uint16_t bg, uint8_t size);
+void ili9341_draw_bitmap_indexed_on(ili9341_display_t *d, int16_t x, int16_t y, uint16_t w, uint16_t h,
+                                    uint8_t bpp, const uint8_t *data, const uint16_t *palette);
+
+void ili9341_fill_rect_async_on(ili9341_display_t *d, int16_t x, int16_t y, uint16_t w, uint16_t h,
+                                uint16_t color, ili9341_async_callback_t callback, void *user);
+void ili9341_draw_bitmap_async_on(ili9341_display_t *d, int16_t x, int16_t y, uint16_t w, uint16_t h,
+                                  const uint16_t *data, ili9341_async_callback_t callback, void *user);
+void ili9341_draw_bitmap_be_async_on(ili9341_display_t *d, int16_t x, int16_t y, uint16_t w, uint16_t h,
+                                     const uint8_t *data, ili9341_async_callback_t callback, void *user);
+bool ili9341_async_busy_on(const ili9341_display_t *d);
+void ili9341_async_wait_on(ili9341_display_t *d);
+
+// Render targets
+// Primitives reduce to single pixels and to windows filled in GRAM order
+// (row-major). A target receives only on-screen windows; write() and
+// repeat() together supply exactly w*h pixels before end(). Each display
+// has its own target, the panel target by default, whose ctx is the
+// display it drives. Raw command and set_window calls always go to the
+// panel. write_be() is optional: it takes big-endian pixel bytes, and
+// targets without it are fed converted pixels through write().
+typedef struct ili9341_target {
+    void (*pixel)(void *ctx, uint16_t x, uint16_t y, uint16_t color);
+    void (*window)(void *ctx, uint16_t x, uint16_t y, uint16_t w, uint16_t h);
+    void (*write)(void *ctx, const uint16_t *pixels, size_t count);
+    void (*write_be)(void *ctx, const uint8_t *bytes, size_t count);
+    void (*repeat)(void *ctx, uint16_t color, size_t count);
+    void (*end)(void *ctx);
+} ili9341_target_t;
+
+extern const ili9341_target_t ili9341_panel_target;
+
+void ili9341_set_target(const ili9341_target_t *target, void *ctx);  // NULL restores the panel
+bool ili9341_target_is_panel(void);
+void ili9341_set_target_on(ili9341_display_t *d, const ili9341_target_t *target, void *ctx);
+bool ili9341_target_is_panel_on(const ili9341_display_t *d);
+
+// Recorded drawing
+// While a display has a capture hook installed its primitives do not render;
+// each call is handed to the hook as one op instead, which modules that
+// defer rendering (display lists, the strip renderer) store and later
+// replay with ili9341_op_draw(). Async calls are captured as their
+// blocking equivalents and call back immediately.
+typedef enum {
+    ILI9341_OP_PIXEL = 0,
+    ILI9341_OP_LINE,
+    ILI9341_OP_RECT,
+    ILI9341_OP_FILL_RECT,
+    ILI9341_OP_CIRCLE,
+    ILI9341_OP_FILL_CIRCLE,
+    ILI9341_OP_FILL_ELLIPSE,
+    ILI9341_OP_FILL_RING,
+    ILI9341_OP_FILL_SECTOR,
+    ILI9341_OP_FILL_SPANS,
+    ILI9341_OP_CHAR,
+    ILI9341_OP_STRING,
+    ILI9341_OP_BITMAP,
+    ILI9341_OP_BITMAP_BE,
+    ILI9341_OP_MASK,
+    ILI9341_OP_INDEXED,
+    ILI9341_OP_CUSTOM,      // Primitive from another module, replayed by draw()
+} ili9341_op_type_t;
+
+typedef struct ili9341_op {
+    uint8_t type;           // ili9341_op_type_t
+    uint8_t size;           // Text and MASK scale, INDEXED bits per pixel
+    char c;                 // CHAR
+    int16_t x, y;           // Origin, first endpoint or centre
+    uint16_t w, h;          // Size, second endpoint (LINE, as int16_t), radius in w (circles),
+                            // radii in w, h (ellipses; rings and sectors: outer, inner);
+                            // CUSTOM and FILL_SPANS ops put their bounding box in x, y, w, h
+    int32_t start, end;     // FILL_SECTOR angles; FILL_SPANS span count in start
+    uint16_t color, bg;
+    const void *data;       // STRING text, BITMAP pixels, FILL_SPANS spans, CUSTOM object
+    const uint16_t *palette;                        // INDEXED
+    void (*draw)(ili9341_display_t *d, const struct ili9341_op *op);     // CUSTOM
+} ili9341_op_t;
+
+void ili9341_set_capture(ili9341_capture_t capture, void *ctx);     // NULL draws again
+void ili9341_op_draw(const ili9341_op_t *op);
+void ili9341_set_capture_on(ili9341_display_t *d, ili9341_capture_t capture, void *ctx);
+void ili9341_op_draw_on(ili9341_display_t *d, const ili9341_op_t *op);
+
+// For primitives implemented outside the core: hands op to the capture
+// hook and returns true if one is installed, in which case the primitive
+// must not draw
+bool ili9341_capture(const ili9341_op_t *op);
+bool ili9341_capture_on(ili9341_display_t *d, const ili9341_op_t *op);
+
+// Instrumentation
+// Built with ILI9341_STATS defined (for every file that includes this
+// header), the driver counts what each primitive costs on the bus: calls,
+// bytes clocked out, CS assertions, DC toggles, address windows, pixels
+// written and time spent, from time_us_64(). Traffic is charged to the
+// outermost primitive running, so the spans of a circle count as the
+// circle. Queued transfers start from the DMA interrupt (a worker thread
+// on the host), so each display counts them apart under its transport
+// lock and a snapshot adds them to ILI9341_STAT_ASYNC. Rendering into a
+// RAM target writes no pixels and sends nothing, and flushing it counts as
+// ILI9341_STAT_OTHER. Each display keeps its own counters, which a
+// snapshot adds up; snapshot and reset while no other core is drawing.
+// Without ILI9341_STATS none of this exists and the hooks compile to
+// nothing.
+#ifdef ILI9341_STATS
+void ili9341_stats_snapshot(ili9341_stats_t *stats);
+void ili9341_stats_reset(void);
+// One line per primitive that was used, and a total, via printf
+void ili9341_stats_print(const ili9341_stats_t *stats);
+#endif
 
 // Helper functions
 uint16_t ili9341_color565(uint8_t r, uint8_t g, uint8_t b);
 
-// Global config pointer
+// Config of the selected display
 extern ili9341_config_t *g_display_config;
 
 #endif // ILI9341_H
@@ -0,0 +1,266 @@
+#include "ili9341_canvas.h"
+
+// Canvas transport. The context pointer is an ili9341_canvas_t.
+
+#define LEFT  0
+#define RIGHT 1
+
+static inline ili9341_canvas_t *canvas_state(void *ctx) {
+    return (ili9341_canvas_t *)ctx;
+}
+
+// Give one panel the bus, releasing the other's CS first
+static void canvas_select(ili9341_canvas_t *canvas, int side) {
+    if (canvas->selected == side) return;
+
+    if (canvas->selected >= 0) {
+        canvas->transport[canvas->selected]->end(canvas->transport_ctx[canvas->selected]);
+    }
+    canvas->transport[side]->begin(canvas->transport_ctx[side]);
+    canvas->selected = side;
+}
+
+static void side_command(ili9341_canvas_t *canvas, int side, uint8_t cmd) {
+    canvas_select(canvas, side);
+    canvas->transport[side]->write_command(canvas->transport_ctx[side], cmd);
+}
+
+static void side_data(ili9341_canvas_t *canvas, int side, const uint8_t *data, size_t len) {
+    canvas_select(canvas, side);
+    canvas->transport[side]->write_data(canvas->transport_ctx[side], data, len);
+}
+
+// Address one panel's part of the canvas window, in its own columns
+static void side_window(ili9341_canvas_t *canvas, int side, uint16_t x0, uint16_t x1) {
+    uint16_t y0 = canvas->y0, y1 = canvas->y1;
+
+    if (!canvas->sent[side].valid || canvas->sent[side].x0 != x0 || canvas->sent[side].x1 != x1) {
+        uint8_t cols[4] = { x0 >> 8, x0 & 0xFF, x1 >> 8, x1 & 0xFF };
+        side_command(canvas, side, ILI9341_CASET);
+        side_data(canvas, side, cols, 4);
+    }
+    if (!canvas->sent[side].valid || canvas->sent[side].y0 != y0 || canvas->sent[side].y1 != y1) {
+        uint8_t pages[4] = { y0 >> 8, y0 & 0xFF, y1 >> 8, y1 & 0xFF };
+        side_command(canvas, side, ILI9341_PASET);
+        side_data(canvas, side, pages, 4);
+    }
+    side_command(canvas, side, ILI9341_RAMWR);
+
+    canvas->sent[side].valid = true;
+    canvas->sent[side].x0 = x0;
+    canvas->sent[side].x1 = x1;
+    canvas->sent[side].y0 = y0;
+    canvas->sent[side].y1 = y1;
+}
+
+// Split the canvas window at the seam and start a memory write on each
+// panel it touches
+static void canvas_ram_write(ili9341_canvas_t *canvas) {
+    uint16_t x0 = canvas->x0, x1 = canvas->x1;
+
+    if (x1 < x0) x1 = x0;
+    if (x0 < ILI9341_WIDTH) {
+        side_window(canvas, LEFT, x0, x1 < ILI9341_WIDTH ? x1 : ILI9341_WIDTH - 1);
+    }
+    if (x1 >= ILI9341_WIDTH) {
+        side_window(canvas, RIGHT, (x0 > ILI9341_WIDTH ? x0 : ILI9341_WIDTH) - ILI9341_WIDTH,
+                    x1 - ILI9341_WIDTH);
+    }
+
+    canvas->ram_write = true;
+    canvas->row_bytes = 2 * ((uint32_t)x1 - x0 + 1);
+    canvas->split_bytes = (x0 >= ILI9341_WIDTH) ? 0 :
+                          (x1 < ILI9341_WIDTH) ? canvas->row_bytes : 2 * ((uint32_t)ILI9341_WIDTH - x0);
+    canvas->cursor = 0;
+}
+
+// Panel that takes the next pixel byte, and how many bytes it takes
+// before the row moves on to the other one
+static int route(const ili9341_canvas_t *canvas, uint32_t *room) {
+    if (canvas->cursor < canvas->split_bytes) {
+        *room = canvas->split_bytes - canvas->cursor;
+        return LEFT;
+    }
+    *room = canvas->row_bytes - canvas->cursor;
+    return RIGHT;
+}
+
+static void advance(ili9341_canvas_t *canvas, uint32_t bytes) {
+    canvas->cursor += bytes;
+    if (canvas->cursor >= canvas->row_bytes) canvas->cursor = 0;
+}
+
+// Transport hooks
+
+static void canvas_init(void *ctx) {
+    ili9341_canvas_t *canvas = canvas_state(ctx);
+
+    canvas->selected = -1;
+    canvas->in_transaction = false;
+    canvas->command = ILI9341_NOP;
+    canvas->ram_write = false;
+    canvas->x0 = canvas->y0 = 0;
+    canvas->x1 = ILI9341_MAX_WIDTH - 1;
+    canvas->y1 = ILI9341_HEIGHT - 1;
+    for (int side = 0; side < 2; side++) {
+        canvas->sent[side].valid = false;
+        canvas->transport[side]->init(canvas->transport_ctx[side]);
+    }
+}
+
+static void canvas_reset(void *ctx) {
+    ili9341_canvas_t *canvas = canvas_state(ctx);
+
+    for (int side = 0; side < 2; side++) {
+        canvas->transport[side]->reset(canvas->transport_ctx[side]);
+    }
+}
+
+static void canvas_delay_ms(void *ctx, uint32_t ms) {
+    ili9341_canvas_t *canvas = canvas_state(ctx);
+    canvas->transport[LEFT]->delay_ms(canvas->transport_ctx[LEFT], ms);
+}
+
+static void canvas_begin(void *ctx) {
+    canvas_state(ctx)->in_transaction = true;
+}
+
+static void canvas_end(void *ctx) {
+    ili9341_canvas_t *canvas = canvas_state(ctx);
+
+    if (canvas->selected >= 0) {
+        canvas->transport[canvas->selected]->end(canvas->transport_ctx[canvas->selected]);
+        canvas->selected = -1;
+    }
+    canvas->in_transaction = false;
+}
+
+static void canvas_write_command(void *ctx, uint8_t cmd) {
+    ili9341_canvas_t *canvas = canvas_state(ctx);
+
+    canvas->command = cmd;
+    canvas->param_count = 0;
+    canvas->ram_write = false;
+
+    switch (cmd) {
+        case ILI9341_CASET:
+        case ILI9341_PASET:
+            break;      // Held until RAMWR splits the window
+        case ILI9341_RAMWR:
+            canvas_ram_write(canvas);
+            break;
+        default:
+            // Anything else may move the panels' windows
+            for (int side = 0; side < 2; side++) {
+                canvas->sent[side].valid = false;
+                side_command(canvas, side, cmd);
+            }
+            break;
+    }
+}
+
+static void canvas_write_data(void *ctx, const uint8_t *data, size_t len) {
+    ili9341_canvas_t *canvas = canvas_state(ctx);
+
+    if (canvas->ram_write) {
+        while (len > 0) {
+            uint32_t room;
+            int side = route(canvas, &room);
+            size_t n = len < room ? len : room;
+
+            side_data(canvas, side, data, n);
+            advance(canvas, n);
+            data += n;
+            len -= n;
+        }
+        return;
+    }
+
+    if (canvas->command != ILI9341_CASET && canvas->command != ILI9341_PASET) {
+        side_data(canvas, LEFT, data, len);
+        side_data(canvas, RIGHT, data, len);
+        return;
+    }
+
+    for (size_t i = 0; i < len && canvas->param_count < 4; i++) {
+        canvas->params[canvas->param_count++] = data[i];
+    }
+    if (canvas->param_count < 4) return;
+
+    uint16_t start = ((uint16_t)canvas->params[0] << 8) | canvas->params[1];
+    uint16_t end = ((uint16_t)canvas->params[2] << 8) | canvas->params[3];
+    if (canvas->command == ILI9341_CASET) {
+        canvas->x0 = start;
+        canvas->x1 = end;
+    } else {
+        canvas->y0 = start;
+        canvas->y1 = end;
+    }
+}
+
+static void canvas_write_pixels(void *ctx, const uint16_t *pixels, size_t count) {
+    ili9341_canvas_t *canvas = canvas_state(ctx);
+
+    while (count > 0 && canvas->ram_write) {
+        uint32_t room;
+        int side = route(canvas, &room);
+        size_t n = count < room / 2 ? count : room / 2;
+
+        canvas_select(canvas, side);
+        canvas->transport[side]->write_pixels(canvas->transport_ctx[side], pixels, n);
+        advance(canvas, 2 * n);
+        pixels += n;
+        count -= n;
+    }
+}
+
+static void canvas_fill_pixels(void *ctx, uint16_t color, size_t count) {
+    ili9341_canvas_t *canvas = canvas_state(ctx);
+
+    while (count > 0 && canvas->ram_write) {
+        uint32_t room;
+        int side = route(canvas, &room);
+        size_t n = count < room / 2 ? count : room / 2;
+
+        canvas_select(canvas, side);
+        canvas->transport[side]->fill_pixels(canvas->transport_ctx[side], color, n);
+        advance(canvas, 2 * n);
+        count -= n;
+    }
+}
+
+const ili9341_transport_t ili9341_canvas_transport = {
+    .init = canvas_init,
+    .reset = canvas_reset,
+    .delay_ms = canvas_delay_ms,
+    .begin = canvas_begin,
+    .end = canvas_end,
+    .write_command = canvas_write_command,
+    .write_data = canvas_write_data,
+    .write_pixels = canvas_write_pixels,
+    .fill_pixels = canvas_fill_pixels,
+};
+
+static void canvas_attach(ili9341_canvas_t *canvas, int side, ili9341_config_t *config) {
+#ifdef ILI9341_HOST
+    canvas->transport[side] = config->transport;
+#else
+    canvas->transport[side] = config->transport ? config->transport : &ili9341_pico_transport;
+#endif
+    canvas->transport_ctx[side] = config->transport_ctx ? config->transport_ctx : config;
+}
+
+void ili9341_canvas_init(ili9341_canvas_t *canvas, ili9341_display_t *display,
+                         ili9341_config_t *left, ili9341_config_t *right) {
+    canvas_attach(canvas, LEFT, left);
+    canvas_attach(canvas, RIGHT, right);
+
+    canvas->config = *left;
+    canvas->config.transport = &ili9341_canvas_transport;
+    canvas->config.transport_ctx = canvas;
+    canvas->config.spi_port = NULL;
+
+    ili9341_display_init(display, &canvas->config);
+    display->native_width = ILI9341_MAX_WIDTH;
+    display->width = ILI9341_MAX_WIDTH;
+}
@@ -0,0 +1,63 @@
+#ifndef ILI9341_CANVAS_H
+#define ILI9341_CANVAS_H
+
+#include "ili9341.h"
+
+// Two-panel canvas
+//
+// Two panels side by side driven as one display twice as wide: 640x240,
+// the left panel showing x 0..319 and the right one x 320..639. The canvas
+// is a transport that sits between a display and the two panels'
+// transports. Commands go to both panels, and each address window is
+// split at the seam. Pixel data is routed row by row, so a window that
+// crosses the seam costs one extra window setup and a CS switch per row.
+// Everything that fits on one panel goes to that panel alone.
+//
+//     static ili9341_canvas_t canvas;
+//     static ili9341_display_t wide;
+//     ili9341_canvas_init(&canvas, &wide, &left_config, &right_config);
+//     ili9341_fill_rect(300, 100, 40, 40, RED);       // Straddles the seam
+//
+// Only one panel has CS asserted at a time, so the panels may share an
+// SPI instance. The canvas has no DMA hooks; asynchronous calls on it run
+// synchronously. Keep it in ILI9341_ROTATION_0: MADCTL reaches both
+// panels, but the seam does not move. Hardware scrolling scrolls both
+// panels together. A framebuffer for the canvas needs
+// ILI9341_MAX_WIDTH * ILI9341_HEIGHT pixels.
+
+typedef struct {
+    const ili9341_transport_t *transport[2];    // Left, right
+    void *transport_ctx[2];
+    ili9341_config_t config;                    // Of the canvas display
+
+    int8_t selected;            // Panel with CS asserted, -1 for none
+    bool in_transaction;
+
+    // Command being received and the canvas window it set up
+    uint8_t command;
+    uint8_t param_count;
+    uint8_t params[4];
+    uint16_t x0, x1, y0, y1;
+
+    // Window each panel holds, to skip unchanged CASET/PASET
+    struct {
+        bool valid;
+        uint16_t x0, x1, y0, y1;
+    } sent[2];
+
+    // Memory write in progress: bytes per row and at the seam, and the
+    // byte offset into the current row
+    bool ram_write;
+    uint32_t row_bytes;
+    uint32_t split_bytes;
+    uint32_t cursor;
+} ili9341_canvas_t;
+
+extern const ili9341_transport_t ili9341_canvas_transport;
+
+// Bring up both panels through display and select it. Each config
+// describes one panel as it would be passed to ili9341_init().
+void ili9341_canvas_init(ili9341_canvas_t *canvas, ili9341_display_t *display,
+                         ili9341_config_t *left, ili9341_config_t *right);
+
+#endif // ILI9341_CANVAS_H
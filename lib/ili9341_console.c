@@ -0,0 +1,188 @@
+#include "ili9341_console.h"
+#include <stdio.h>
+#include <string.h>
+
+// Longest ili9341_console_printf() output; the rest is cut
+#define PRINTF_MAX 256
+
+static inline uint16_t line_height(const ili9341_console_t *console) {
+    return 8 * console->size;
+}
+
+// Grid line shown at screen row row of the console
+static inline uint8_t grid_line(const ili9341_console_t *console, uint8_t row) {
+    return (console->first + row) % console->rows;
+}
+
+// Point the panel's scroll ring at the console, showing grid line first
+// at the top
+static void scroll_to_first(ili9341_console_t *console) {
+    ili9341_scroll_set(console->first * line_height(console));
+    console->shown_first = console->first;
+}
+
+static void define_scroll(ili9341_console_t *console) {
+    uint16_t area = console->rows * line_height(console);
+
+    ili9341_scroll_define(console->y, ILI9341_HEIGHT - console->y - area);
+    scroll_to_first(console);
+}
+
+// Redraw the cells of a grid line that differ from what is on screen, one
+// opaque string per run of changed cells
+static void flush_line(ili9341_console_t *console, uint8_t line) {
+    const char *text = console->text[line];
+    char *shown = console->shown[line];
+    char run[ILI9341_CONSOLE_COLS + 1];
+    uint16_t y = console->y + line * line_height(console);
+    uint8_t i = 0;
+
+    while (i < console->cols) {
+        if (text[i] == shown[i]) {
+            i++;
+            continue;
+        }
+
+        uint8_t from = i;
+        while (i < console->cols && text[i] != shown[i]) {
+            run[i - from] = text[i];
+            shown[i] = text[i];
+            i++;
+        }
+        run[i - from] = '\0';
+        ili9341_draw_string(from * 6 * console->size, y, run, console->color, console->bg, console->size);
+    }
+    console->dirty[line] = false;
+}
+
+// Scroll first, so lines that moved are drawn where they now show
+static void flush(ili9341_console_t *console) {
+    if (console->first != console->shown_first) scroll_to_first(console);
+
+    for (uint8_t line = 0; line < console->rows; line++) {
+        if (console->dirty[line]) flush_line(console, line);
+    }
+}
+
+static void clear_line(ili9341_console_t *console, uint8_t line) {
+    memset(console->text[line], ' ', console->cols);
+    console->dirty[line] = true;
+}
+
+static void newline(ili9341_console_t *console) {
+    console->col = 0;
+    if (console->row + 1 < console->rows) {
+        console->row++;
+        return;
+    }
+
+    // The top line scrolls out and comes back in as the bottom one
+    console->first = (console->first + 1) % console->rows;
+    clear_line(console, grid_line(console, console->row));
+}
+
+static void put(ili9341_console_t *console, char c) {
+    switch (c) {
+        case '\n':
+            newline(console);
+            return;
+        case '\r':
+            console->col = 0;
+            return;
+        case '\t':
+            do {
+                put(console, ' ');
+            } while (console->col % 8 != 0 && console->col < console->cols);
+            return;
+        case '\f':
+            ili9341_console_clear(console);
+            return;
+    }
+    if ((unsigned char)c < ' ') return;
+
+    // Wrap only when another character arrives, so a line that exactly
+    // fills the width followed by '\n' does not leave a blank line
+    if (console->col >= console->cols) newline(console);
+
+    uint8_t line = grid_line(console, console->row);
+    console->text[line][console->col++] = c;
+    console->dirty[line] = true;
+}
+
+void ili9341_console_init(ili9341_console_t *console, uint16_t y, uint8_t rows, uint8_t size,
+                          uint16_t color, uint16_t bg) {
+    if (size == 0) size = 1;
+    if (size > ILI9341_HEIGHT / 8) size = ILI9341_HEIGHT / 8;
+    if (y > ILI9341_HEIGHT - 8 * size) y = ILI9341_HEIGHT - 8 * size;
+
+    uint8_t fit = (ILI9341_HEIGHT - y) / (8 * size);
+    console->y = y;
+    console->size = size;
+    console->cols = ILI9341_WIDTH / (6 * size);
+    console->rows = (rows == 0 || rows > fit) ? fit : rows;
+    console->color = color;
+    console->bg = bg;
+    console->col = 0;
+    console->row = 0;
+    console->first = 0;
+
+    for (uint8_t line = 0; line < console->rows; line++) {
+        memset(console->text[line], ' ', console->cols);
+        memset(console->shown[line], ' ', console->cols);
+        console->dirty[line] = false;
+    }
+
+    define_scroll(console);
+    ili9341_fill_rect(0, y, ILI9341_WIDTH, console->rows * line_height(console), bg);
+}
+
+void ili9341_console_putc(ili9341_console_t *console, char c) {
+    put(console, c);
+    flush(console);
+}
+
+void ili9341_console_write(ili9341_console_t *console, const char *text, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        put(console, text[i]);
+    }
+    flush(console);
+}
+
+void ili9341_console_puts(ili9341_console_t *console, const char *text) {
+    ili9341_console_write(console, text, strlen(text));
+}
+
+void ili9341_console_vprintf(ili9341_console_t *console, const char *format, va_list args) {
+    char buffer[PRINTF_MAX];
+    int len = vsnprintf(buffer, sizeof(buffer), format, args);
+
+    if (len < 0) return;
+    ili9341_console_write(console, buffer, (size_t)len < sizeof(buffer) ? (size_t)len : sizeof(buffer) - 1);
+}
+
+void ili9341_console_printf(ili9341_console_t *console, const char *format, ...) {
+    va_list args;
+
+    va_start(args, format);
+    ili9341_console_vprintf(console, format, args);
+    va_end(args);
+}
+
+void ili9341_console_clear(ili9341_console_t *console) {
+    for (uint8_t line = 0; line < console->rows; line++) {
+        clear_line(console, line);
+    }
+    console->col = 0;
+    console->row = 0;
+}
+
+void ili9341_console_redraw(ili9341_console_t *console) {
+    // Text never holds '\0', so every cell differs
+    for (uint8_t line = 0; line < console->rows; line++) {
+        memset(console->shown[line], '\0', console->cols);
+        console->dirty[line] = true;
+    }
+
+    define_scroll(console);
+    flush(console);
+}
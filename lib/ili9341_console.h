@@ -0,0 +1,67 @@
+#ifndef ILI9341_CONSOLE_H
+#define ILI9341_CONSOLE_H
+
+#include "ili9341.h"
+#include <stdarg.h>
+
+// Scrolling text console
+//
+// A grid of character cells over a band of full-width rows, for logs and
+// status output. Text is written like a terminal: '\n' starts a new line,
+// '\r' returns to its start, '\t' moves to the next multiple of 8 columns
+// and '\f' clears the console; other control characters are ignored.
+// Lines longer than the grid wrap. Once the cursor is on the last line, a
+// new line scrolls the console with the panel's hardware scroll instead of
+// repainting it: the top line becomes the new bottom one and only the
+// cells that differ get redrawn.
+//
+// Every output call ends by pushing its changes to the panel, with at most
+// one scroll command however many lines it scrolled. Changed cells are
+// drawn as opaque strings, one per run of changed cells in a line.
+//
+//     static ili9341_console_t console;
+//     ili9341_console_init(&console, 0, 30, 1, GREEN, BLACK);
+//     ili9341_console_printf(&console, "speed %d\n", speed);
+//
+// The console owns the scroll area: it defines the rows from y to the end
+// of its grid as the ring and everything else as fixed, so other drawing
+// belongs above or below it. Scrolling goes straight to the panel, so the
+// console does not work under a framebuffer or a display list, and since
+// the panel only scrolls along its own rows it needs ILI9341_ROTATION_0.
+
+#define ILI9341_CONSOLE_COLS (ILI9341_WIDTH / 6)
+#define ILI9341_CONSOLE_ROWS (ILI9341_HEIGHT / 8)
+
+typedef struct {
+    uint16_t y;                 // Top row on screen
+    uint8_t size;
+    uint8_t cols, rows;
+    uint16_t color, bg;
+
+    uint8_t col, row;           // Cursor, row 0 = top line on screen
+    uint8_t first;              // Grid line shown at the top
+
+    // Lines are indexed by grid line, which stays put in GRAM as the
+    // console scrolls: line i is drawn at y + i * 8 * size
+    char text[ILI9341_CONSOLE_ROWS][ILI9341_CONSOLE_COLS];
+    char shown[ILI9341_CONSOLE_ROWS][ILI9341_CONSOLE_COLS];    // Cells on screen
+    bool dirty[ILI9341_CONSOLE_ROWS];
+    uint8_t shown_first;
+} ili9341_console_t;
+
+// Set up a console of rows lines at y, in text of the given size, and
+// clear it. rows is cut to what fits below y; 0 means all of it.
+void ili9341_console_init(ili9341_console_t *console, uint16_t y, uint8_t rows, uint8_t size,
+                          uint16_t color, uint16_t bg);
+
+void ili9341_console_putc(ili9341_console_t *console, char c);
+void ili9341_console_write(ili9341_console_t *console, const char *text, size_t len);
+void ili9341_console_puts(ili9341_console_t *console, const char *text);     // No newline added
+void ili9341_console_printf(ili9341_console_t *console, const char *format, ...);
+void ili9341_console_vprintf(ili9341_console_t *console, const char *format, va_list args);
+void ili9341_console_clear(ili9341_console_t *console);
+
+// Redraw every cell, e.g. after something else painted over the console
+void ili9341_console_redraw(ili9341_console_t *console);
+
+#endif // ILI9341_CONSOLE_H
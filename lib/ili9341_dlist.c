@@ -0,0 +1,491 @@
+#include "ili9341_dlist.h"
+#include <string.h>
+
+// Records are packed back to back in the arena, each followed by its inline
+// text (if any) and padded to the record alignment
+typedef struct {
+    ili9341_op_t op;
+    ili9341_span_t clip;        // Clip rectangle the op was drawn under
+    bool clipped;               // False if it was the screen
+    int32_t x0, y0, x1, y1;     // Bounding box, inclusive, may lie off-screen
+    uint16_t bytes;             // Record size including text and padding
+} dl_record_t;
+
+#define RECORD_ALIGN _Alignof(dl_record_t)
+
+static inline size_t align_up(size_t n) {
+    return (n + RECORD_ALIGN - 1) & ~(size_t)(RECORD_ALIGN - 1);
+}
+
+// Pixels an op can touch. Text cells are 5x8 glyphs on a 6-pixel advance.
+static void op_bounds(dl_record_t *rec) {
+    const ili9341_op_t *op = &rec->op;
+    int32_t x = op->x, y = op->y;
+
+    switch (op->type) {
+        case ILI9341_OP_LINE: {
+            int32_t x1 = (int16_t)op->w, y1 = (int16_t)op->h;
+            rec->x0 = x < x1 ? x : x1;
+            rec->x1 = x > x1 ? x : x1;
+            rec->y0 = y < y1 ? y : y1;
+            rec->y1 = y > y1 ? y : y1;
+            return;
+        }
+        case ILI9341_OP_CIRCLE:
+        case ILI9341_OP_FILL_CIRCLE:
+        case ILI9341_OP_FILL_RING:
+        case ILI9341_OP_FILL_SECTOR:
+            rec->x0 = x - op->w;
+            rec->x1 = x + op->w;
+            rec->y0 = y - op->w;
+            rec->y1 = y + op->w;
+            return;
+        case ILI9341_OP_FILL_ELLIPSE:
+            rec->x0 = x - op->w;
+            rec->x1 = x + op->w;
+            rec->y0 = y - op->h;
+            rec->y1 = y + op->h;
+            return;
+        case ILI9341_OP_CHAR:
+            rec->x1 = x + 5 * op->size - 1;
+            rec->y1 = y + 8 * op->size - 1;
+            break;
+        case ILI9341_OP_STRING:
+            rec->x1 = x + (int32_t)strlen((const char *)op->data) * 6 * op->size - 1;
+            rec->y1 = y + 8 * op->size - 1;
+            break;
+        case ILI9341_OP_MASK:
+            rec->x1 = x + op->w * op->size - 1;
+            rec->y1 = y + op->h * op->size - 1;
+            break;
+        case ILI9341_OP_RECT:
+        case ILI9341_OP_FILL_RECT:
+        case ILI9341_OP_BITMAP:
+        case ILI9341_OP_BITMAP_BE:
+        case ILI9341_OP_INDEXED:
+        case ILI9341_OP_FILL_SPANS:
+        case ILI9341_OP_CUSTOM:
+            rec->x1 = x + op->w - 1;
+            rec->y1 = y + op->h - 1;
+            break;
+        default:
+            rec->x1 = x;
+            rec->y1 = y;
+            break;
+    }
+    rec->x0 = x;
+    rec->y0 = y;
+}
+
+// Cut the bounding box to the clip; nothing outside it is drawn
+static void clip_bounds(dl_record_t *rec) {
+    int32_t x1 = (int32_t)rec->clip.x + rec->clip.w - 1;
+    int32_t y1 = (int32_t)rec->clip.y + rec->clip.h - 1;
+
+    if (!rec->clipped) return;
+    if (rec->x0 < rec->clip.x) rec->x0 = rec->clip.x;
+    if (rec->y0 < rec->clip.y) rec->y0 = rec->clip.y;
+    if (rec->x1 > x1) rec->x1 = x1;
+    if (rec->y1 > y1) rec->y1 = y1;
+}
+
+// Replay an op under the clip it was recorded with
+static void record_draw(const dl_record_t *rec) {
+    if (!rec->clipped) {
+        ili9341_op_draw(&rec->op);
+        return;
+    }
+    if (ili9341_clip_push(rec->clip.x, rec->clip.y, rec->clip.w, rec->clip.h)) {
+        ili9341_op_draw(&rec->op);
+        ili9341_clip_pop();
+    }
+}
+
+static void dlist_capture(void *ctx, const ili9341_op_t *op) {
+    ili9341_dlist_t *list = (ili9341_dlist_t *)ctx;
+    size_t text = (op->type == ILI9341_OP_STRING) ? strlen((const char *)op->data) + 1 : 0;
+    size_t bytes = align_up(sizeof(dl_record_t) + text);
+
+    if (list->used + bytes > list->capacity || bytes > UINT16_MAX) {
+        list->overflow = true;
+        return;
+    }
+
+    dl_record_t *rec = (dl_record_t *)(list->arena + list->used);
+    rec->op = *op;
+    rec->bytes = bytes;
+    if (text) {
+        char *copy = (char *)(rec + 1);
+        memcpy(copy, op->data, text);
+        rec->op.data = copy;
+    }
+    rec->clipped = ili9341_clip_get(&rec->clip);
+    op_bounds(rec);
+    clip_bounds(rec);
+
+    list->used += bytes;
+    list->count++;
+}
+
+void ili9341_dlist_init(ili9341_dlist_t *list, void *arena, size_t capacity) {
+    // Start the first record on an aligned address
+    uintptr_t start = (uintptr_t)arena;
+    size_t skip = align_up(start) - start;
+
+    list->arena = (uint8_t *)arena + (skip < capacity ? skip : capacity);
+    list->capacity = skip < capacity ? capacity - skip : 0;
+    ili9341_dlist_clear(list);
+}
+
+void ili9341_dlist_clear(ili9341_dlist_t *list) {
+    list->used = 0;
+    list->count = 0;
+    list->overflow = false;
+}
+
+void ili9341_dlist_begin(ili9341_dlist_t *list) {
+    ili9341_set_capture(dlist_capture, list);
+}
+
+void ili9341_dlist_end(void) {
+    ili9341_set_capture(NULL, NULL);
+}
+
+void ili9341_dlist_replay(const ili9341_dlist_t *list) {
+    for (size_t at = 0; at < list->used;) {
+        const dl_record_t *rec = (const dl_record_t *)(list->arena + at);
+        record_draw(rec);
+        at += rec->bytes;
+    }
+}
+
+// Optimizer
+//
+// Works on boxes cut to the screen and to each record's clip. A record is
+// dropped once a later record is known to overwrite every pixel it could
+// touch, so only ops that write each pixel of their box (fills, bitmaps,
+// opaque text and masks) occlude. Fills rewritten here are cut to their
+// clip and lose it.
+// Records are moved as raw bytes; the text pointer of a STRING record is
+// its own inline copy and is refreshed after every move.
+
+#define DL_DROPPED 0xFF
+
+typedef struct {
+    int32_t x0, y0, x1, y1;
+} dl_box_t;
+
+static inline bool box_empty(const dl_box_t *b) {
+    return b->x0 > b->x1 || b->y0 > b->y1;
+}
+
+static inline bool box_intersects(const dl_box_t *a, const dl_box_t *b) {
+    return a->x0 <= b->x1 && b->x0 <= a->x1 && a->y0 <= b->y1 && b->y0 <= a->y1;
+}
+
+static inline bool box_contains(const dl_box_t *outer, const dl_box_t *inner) {
+    return outer->x0 <= inner->x0 && outer->x1 >= inner->x1 &&
+           outer->y0 <= inner->y0 && outer->y1 >= inner->y1;
+}
+
+static dl_box_t box_clip(int32_t x0, int32_t y0, int32_t x1, int32_t y1) {
+    dl_box_t b = {
+        x0 > 0 ? x0 : 0,
+        y0 > 0 ? y0 : 0,
+        x1 < ili9341_width() - 1 ? x1 : ili9341_width() - 1,
+        y1 < ili9341_height() - 1 ? y1 : ili9341_height() - 1,
+    };
+    return b;
+}
+
+static inline dl_box_t record_box(const dl_record_t *rec) {
+    return box_clip(rec->x0, rec->y0, rec->x1, rec->y1);
+}
+
+static inline const char *record_text(const dl_record_t *rec) {
+    return (const char *)(rec + 1);
+}
+
+static dl_box_t op_cover(const dl_record_t *rec);
+
+// The pixels the op is certain to overwrite, or an empty box
+static dl_box_t record_cover(const dl_record_t *rec) {
+    dl_box_t cover = op_cover(rec);
+    dl_box_t box = record_box(rec);
+
+    if (cover.x0 < box.x0) cover.x0 = box.x0;
+    if (cover.y0 < box.y0) cover.y0 = box.y0;
+    if (cover.x1 > box.x1) cover.x1 = box.x1;
+    if (cover.y1 > box.y1) cover.y1 = box.y1;
+    return cover;
+}
+
+// What the op overwrites, before its clip
+static dl_box_t op_cover(const dl_record_t *rec) {
+    const ili9341_op_t *op = &rec->op;
+    dl_box_t none = { 0, 0, -1, -1 };
+    int32_t x = op->x, y = op->y;
+
+    switch (op->type) {
+        case ILI9341_OP_FILL_RECT:
+        case ILI9341_OP_BITMAP:
+        case ILI9341_OP_BITMAP_BE:
+        case ILI9341_OP_INDEXED:
+            if (op->w == 0 || op->h == 0) return none;
+            return box_clip(x, y, x + op->w - 1, y + op->h - 1);
+        case ILI9341_OP_MASK:
+            if (op->bg == op->color || op->size == 0 || op->w == 0 || op->h == 0) return none;
+            return box_clip(x, y, x + op->w * op->size - 1, y + op->h * op->size - 1);
+        case ILI9341_OP_CHAR:
+        case ILI9341_OP_STRING: {
+            // Opaque text covers its cells and the gaps between them
+            int32_t len = (op->type == ILI9341_OP_CHAR) ? 1 : (int32_t)strlen(record_text(rec));
+            if (op->bg == op->color || op->size == 0 || len == 0) return none;
+            return box_clip(x, y, x + len * 6 * op->size - op->size - 1, y + 8 * op->size - 1);
+        }
+        default:
+            return none;
+    }
+}
+
+static inline dl_record_t *record_at(const ili9341_dlist_t *list, size_t at) {
+    return (dl_record_t *)(list->arena + at);
+}
+
+// Drop records that draw nothing on screen or that a later record
+// overwrites completely
+static void cull_hidden(ili9341_dlist_t *list) {
+    for (size_t at = 0; at < list->used; at += record_at(list, at)->bytes) {
+        dl_record_t *rec = record_at(list, at);
+        dl_box_t box = record_box(rec);
+        bool hidden = box_empty(&box);
+
+        for (size_t later = at + rec->bytes; !hidden && later < list->used;
+             later += record_at(list, later)->bytes) {
+            const dl_record_t *next = record_at(list, later);
+            if (next->op.type == DL_DROPPED) continue;
+
+            dl_box_t cover = record_cover(next);
+            hidden = !box_empty(&cover) && box_contains(&cover, &box);
+        }
+
+        if (hidden) rec->op.type = DL_DROPPED;
+    }
+}
+
+// Pixels a fill must save before it is split into more windows, about
+// what the extra CASET/PASET/RAMWR costs on the wire
+#define SPLIT_SLACK 16
+
+static void set_fill_box(dl_record_t *rec, const dl_box_t *box);
+
+// Cut the parts of each fill that later records overwrite. A cover that
+// takes a whole band off one side shrinks the fill in place; one that
+// leaves up to four pieces splits it, if that saves enough pixels and the
+// arena has room for the new records.
+static void trim_fills(ili9341_dlist_t *list) {
+    for (size_t at = 0; at < list->used; at += record_at(list, at)->bytes) {
+        dl_record_t *rec = record_at(list, at);
+        if (rec->op.type != ILI9341_OP_FILL_RECT) continue;
+
+        for (size_t later = at + rec->bytes; later < list->used; later += record_at(list, later)->bytes) {
+            dl_box_t a = record_box(rec);
+            dl_box_t c = record_cover(record_at(list, later));
+            if (box_empty(&c) || !box_intersects(&a, &c)) continue;
+            if (box_contains(&c, &a)) {
+                rec->op.type = DL_DROPPED;
+                break;
+            }
+
+            // What is left: bands above and below the cover, then the
+            // parts beside it
+            dl_box_t pieces[4];
+            int n = 0;
+            int32_t m0 = a.y0 > c.y0 ? a.y0 : c.y0;
+            int32_t m1 = a.y1 < c.y1 ? a.y1 : c.y1;
+            if (c.y0 > a.y0) pieces[n++] = (dl_box_t){ a.x0, a.y0, a.x1, c.y0 - 1 };
+            if (c.y1 < a.y1) pieces[n++] = (dl_box_t){ a.x0, c.y1 + 1, a.x1, a.y1 };
+            if (c.x0 > a.x0) pieces[n++] = (dl_box_t){ a.x0, m0, c.x0 - 1, m1 };
+            if (c.x1 < a.x1) pieces[n++] = (dl_box_t){ c.x1 + 1, m0, a.x1, m1 };
+
+            if (n > 1) {
+                int32_t saved = ((a.x1 < c.x1 ? a.x1 : c.x1) - (a.x0 > c.x0 ? a.x0 : c.x0) + 1) * (m1 - m0 + 1);
+                size_t extra = (size_t)(n - 1) * rec->bytes;
+                if (saved <= (n - 1) * SPLIT_SLACK || list->used + extra > list->capacity ||
+                    list->count + n - 1 > UINT16_MAX) {
+                    continue;
+                }
+
+                // The new pieces go right after this record; text pointers
+                // behind them are refreshed by compact()
+                uint8_t *next = list->arena + at + rec->bytes;
+                memmove(next + extra, next, list->used - (at + rec->bytes));
+                for (int i = 1; i < n; i++) {
+                    dl_record_t *piece = (dl_record_t *)(next + (size_t)(i - 1) * rec->bytes);
+                    memcpy(piece, rec, rec->bytes);
+                    set_fill_box(piece, &pieces[i]);
+                }
+                list->used += extra;
+                list->count += n - 1;
+                later += extra;
+            }
+            set_fill_box(rec, &pieces[0]);
+        }
+    }
+}
+
+// True if no live record strictly between first and last touches box
+static bool nothing_between(const ili9341_dlist_t *list, size_t first, size_t last, const dl_box_t *box) {
+    for (size_t at = first + record_at(list, first)->bytes; at < last; at += record_at(list, at)->bytes) {
+        const dl_record_t *rec = record_at(list, at);
+        if (rec->op.type == DL_DROPPED) continue;
+
+        dl_box_t other = record_box(rec);
+        if (box_intersects(&other, box)) return false;
+    }
+    return true;
+}
+
+static void set_fill_box(dl_record_t *rec, const dl_box_t *box) {
+    rec->op.x = box->x0;
+    rec->op.y = box->y0;
+    rec->op.w = box->x1 - box->x0 + 1;
+    rec->op.h = box->y1 - box->y0 + 1;
+    rec->clipped = false;
+    op_bounds(rec);
+}
+
+// Merge pairs of same-color fills whose union is a rectangle. The merged
+// fill takes the later slot if nothing in between touches the earlier one,
+// or the earlier slot if nothing in between touches the later one.
+static void merge_fills(ili9341_dlist_t *list) {
+    bool changed = true;
+
+    while (changed) {
+        changed = false;
+        for (size_t at = 0; at < list->used; at += record_at(list, at)->bytes) {
+            dl_record_t *a = record_at(list, at);
+            if (a->op.type != ILI9341_OP_FILL_RECT) continue;
+
+            for (size_t later = at + a->bytes; later < list->used; later += record_at(list, later)->bytes) {
+                dl_record_t *b = record_at(list, later);
+                if (b->op.type != ILI9341_OP_FILL_RECT || b->op.color != a->op.color) continue;
+
+                dl_box_t ba = record_box(a), bb = record_box(b);
+                bool columns = ba.x0 == bb.x0 && ba.x1 == bb.x1 && ba.y0 <= bb.y1 + 1 && bb.y0 <= ba.y1 + 1;
+                bool rows = ba.y0 == bb.y0 && ba.y1 == bb.y1 && ba.x0 <= bb.x1 + 1 && bb.x0 <= ba.x1 + 1;
+                if (!columns && !rows) continue;
+
+                dl_box_t u = box_clip(ba.x0 < bb.x0 ? ba.x0 : bb.x0, ba.y0 < bb.y0 ? ba.y0 : bb.y0,
+                                      ba.x1 > bb.x1 ? ba.x1 : bb.x1, ba.y1 > bb.y1 ? ba.y1 : bb.y1);
+                if (nothing_between(list, at, later, &ba)) {
+                    set_fill_box(b, &u);
+                    a->op.type = DL_DROPPED;
+                    changed = true;
+                    break;
+                }
+                if (nothing_between(list, at, later, &bb)) {
+                    // a grows and keeps looking for partners
+                    set_fill_box(a, &u);
+                    b->op.type = DL_DROPPED;
+                    changed = true;
+                }
+            }
+        }
+    }
+}
+
+static void fix_text(dl_record_t *rec) {
+    if (rec->op.type == ILI9341_OP_STRING) rec->op.data = record_text(rec);
+}
+
+// Squeeze out dropped records
+static void compact(ili9341_dlist_t *list) {
+    size_t out = 0;
+
+    for (size_t at = 0; at < list->used;) {
+        dl_record_t *rec = record_at(list, at);
+        uint16_t bytes = rec->bytes;
+
+        if (rec->op.type != DL_DROPPED) {
+            if (out != at) memmove(list->arena + out, rec, bytes);
+            fix_text(record_at(list, out));
+            out += bytes;
+        } else {
+            list->count--;
+        }
+        at += bytes;
+    }
+    list->used = out;
+}
+
+static void reverse_bytes(uint8_t *first, uint8_t *last) {
+    while (first < last) {
+        uint8_t t = *first;
+        *first++ = *--last;
+        *last = t;
+    }
+}
+
+// Rotate [first, last) so that middle comes first
+static void rotate_bytes(uint8_t *first, uint8_t *middle, uint8_t *last) {
+    reverse_bytes(first, middle);
+    reverse_bytes(middle, last);
+    reverse_bytes(first, last);
+}
+
+static inline bool window_before(const dl_box_t *a, const dl_box_t *b) {
+    return a->y0 < b->y0 || (a->y0 == b->y0 && a->x0 < b->x0);
+}
+
+// Insertion sort by window origin, top to bottom then left to right. A
+// record only moves ahead of records it does not overlap, so the picture
+// is unchanged; the point is to send neighbouring windows back to back,
+// which lets the driver skip repeated CASET/PASET.
+static void sort_windows(ili9341_dlist_t *list) {
+    for (size_t at = 0; at < list->used;) {
+        dl_record_t *rec = record_at(list, at);
+        uint16_t bytes = rec->bytes;
+        dl_box_t box = record_box(rec);
+
+        // Start of the run of records just before rec that it may pass
+        size_t dest = at;
+        for (size_t prev = 0; prev < at; prev += record_at(list, prev)->bytes) {
+            dl_box_t other = record_box(record_at(list, prev));
+            if (window_before(&box, &other) && !box_intersects(&box, &other)) {
+                if (dest == at) dest = prev;
+            } else {
+                dest = at;
+            }
+        }
+
+        if (dest != at) {
+            rotate_bytes(list->arena + dest, list->arena + at, list->arena + at + bytes);
+            for (size_t fix = dest; fix < at + bytes; fix += record_at(list, fix)->bytes) {
+                fix_text(record_at(list, fix));
+            }
+        }
+        at += bytes;
+    }
+}
+
+int32_t ili9341_dlist_optimize(ili9341_dlist_t *list) {
+    int32_t before = list->count;
+
+    cull_hidden(list);
+    compact(list);
+    trim_fills(list);
+    compact(list);
+    sort_windows(list);
+    merge_fills(list);
+    compact(list);
+    return before - list->count;
+}
+
+void ili9341_dlist_replay_rows(const ili9341_dlist_t *list, uint16_t y0, uint16_t y1) {
+    for (size_t at = 0; at < list->used;) {
+        const dl_record_t *rec = (const dl_record_t *)(list->arena + at);
+        if (rec->y1 >= y0 && rec->y0 <= y1) record_draw(rec);
+        at += rec->bytes;
+    }
+}
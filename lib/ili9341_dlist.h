@@ -0,0 +1,47 @@
+#ifndef ILI9341_DLIST_H
+#define ILI9341_DLIST_H
+
+#include "ili9341.h"
+
+// Display lists
+//
+// Between ili9341_dlist_begin() and ili9341_dlist_end() the drawing
+// primitives are recorded into a caller-supplied arena instead of being
+// rendered. Each record keeps the op, the clip rectangle it was drawn
+// under and its bounding box, so a list can be replayed whole or only where
+// it touches a band of rows. Replay pushes each op's clip on top of
+// whatever clip is current. String text is copied into the arena; bitmap
+// pixels and ili9341_fill_spans() tables are referenced and must outlive
+// the list.
+
+typedef struct {
+    uint8_t *arena;
+    size_t capacity;
+    size_t used;
+    uint16_t count;         // Ops recorded
+    bool overflow;          // An op did not fit and was dropped
+} ili9341_dlist_t;
+
+void ili9341_dlist_init(ili9341_dlist_t *list, void *arena, size_t capacity);
+void ili9341_dlist_clear(ili9341_dlist_t *list);
+
+// Record drawing calls into list (appending) until ili9341_dlist_end()
+void ili9341_dlist_begin(ili9341_dlist_t *list);
+void ili9341_dlist_end(void);
+
+// Rewrite a recorded list to draw the same picture for less bus traffic:
+// ops completely overwritten by a later fill, bitmap or opaque text are
+// dropped, fills lose the parts such ops overwrite, ops are reordered by
+// window origin where they do not overlap, and same-color fills that
+// together form a rectangle are merged. Meant for static screens recorded
+// once and replayed often. Splitting a fill around a cover needs free
+// arena space; without it fills are only trimmed. Coverage is clipped to
+// the screen in the current rotation. Returns the number of ops removed,
+// negative if splits added more than were removed.
+int32_t ili9341_dlist_optimize(ili9341_dlist_t *list);
+
+// Draw the recorded ops in order, or only those touching rows y0..y1
+void ili9341_dlist_replay(const ili9341_dlist_t *list);
+void ili9341_dlist_replay_rows(const ili9341_dlist_t *list, uint16_t y0, uint16_t y1);
+
+#endif // ILI9341_DLIST_H
@@ -0,0 +1,219 @@
+#include "ili9341_fb.h"
+
+// Inclusive rectangle, plus how many of its pixels were actually drawn
+// (an estimate once overlapping regions have been merged)
+typedef struct {
+    uint16_t x0, y0, x1, y1;
+    uint32_t used;
+} fb_rect_t;
+
+static struct {
+    uint16_t *buffer;
+    uint16_t width, height;     // Screen size, and the buffer's row stride
+    fb_rect_t dirty[ILI9341_FB_MAX_DIRTY + 1];     // +1 scratch slot
+    uint8_t dirty_count;
+
+    // Window being streamed by the target
+    uint16_t wx, wy, ww;
+    uint32_t cursor;
+} g_fb;
+
+// Dirty rectangle bookkeeping
+
+static inline uint32_t rect_area(const fb_rect_t *r) {
+    return (uint32_t)(r->x1 - r->x0 + 1) * (r->y1 - r->y0 + 1);
+}
+
+static inline fb_rect_t rect_union(const fb_rect_t *a, const fb_rect_t *b) {
+    fb_rect_t u = {
+        a->x0 < b->x0 ? a->x0 : b->x0,
+        a->y0 < b->y0 ? a->y0 : b->y0,
+        a->x1 > b->x1 ? a->x1 : b->x1,
+        a->y1 > b->y1 ? a->y1 : b->y1,
+        a->used + b->used,
+    };
+    uint32_t area = rect_area(&u);
+    if (u.used > area) u.used = area;
+    return u;
+}
+
+// Pixels a merged window would send that were never drawn. Measured against
+// what both sides really used, so a chain of cheap merges (a diagonal line
+// drawn pixel by pixel) cannot grow into a mostly empty bounding box.
+static int32_t merge_waste(const fb_rect_t *a, const fb_rect_t *b) {
+    fb_rect_t u = rect_union(a, b);
+    return (int32_t)rect_area(&u) - (int32_t)u.used;
+}
+
+static inline fb_rect_t make_rect(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1) {
+    fb_rect_t r = { x0, y0, x1, y1, 0 };
+    r.used = rect_area(&r);
+    return r;
+}
+
+static void dirty_add(fb_rect_t r) {
+    // Common case: another pixel of the region drawn last
+    if (g_fb.dirty_count) {
+        const fb_rect_t *last = &g_fb.dirty[g_fb.dirty_count - 1];
+        if (r.x0 >= last->x0 && r.x1 <= last->x1 && r.y0 >= last->y0 && r.y1 <= last->y1) return;
+    }
+
+    // Absorb every rectangle that is cheaper to send together with r. A
+    // merge can make r overlap rectangles it skipped, so rescan after each.
+    for (int i = 0; i < g_fb.dirty_count; i++) {
+        if (merge_waste(&r, &g_fb.dirty[i]) <= ILI9341_FB_MERGE_SLACK) {
+            r = rect_union(&r, &g_fb.dirty[i]);
+            g_fb.dirty[i] = g_fb.dirty[--g_fb.dirty_count];
+            i = -1;
+        }
+    }
+
+    // Out of slots: merge whichever pair, r included, wastes the fewest
+    // pixels. Slot ILI9341_FB_MAX_DIRTY temporarily holds r.
+    if (g_fb.dirty_count == ILI9341_FB_MAX_DIRTY) {
+        fb_rect_t *d = g_fb.dirty;
+        int n = ILI9341_FB_MAX_DIRTY + 1;
+        int best_a = 0, best_b = 1;
+        int32_t best_waste = INT32_MAX;
+
+        d[ILI9341_FB_MAX_DIRTY] = r;
+        for (int a = 0; a < n; a++) {
+            for (int b = a + 1; b < n; b++) {
+                int32_t waste = merge_waste(&d[a], &d[b]);
+                if (waste < best_waste) {
+                    best_a = a;
+                    best_b = b;
+                    best_waste = waste;
+                }
+            }
+        }
+        d[best_a] = rect_union(&d[best_a], &d[best_b]);
+        d[best_b] = d[ILI9341_FB_MAX_DIRTY];
+        return;
+    }
+
+    g_fb.dirty[g_fb.dirty_count++] = r;
+}
+
+// Render target
+
+static void fb_pixel(void *ctx, uint16_t x, uint16_t y, uint16_t color) {
+    (void)ctx;
+    g_fb.buffer[(uint32_t)y * g_fb.width + x] = color;
+    dirty_add(make_rect(x, y, x, y));
+}
+
+static void fb_window(void *ctx, uint16_t x, uint16_t y, uint16_t w, uint16_t h) {
+    (void)ctx;
+    g_fb.wx = x;
+    g_fb.wy = y;
+    g_fb.ww = w;
+    g_fb.cursor = 0;
+    dirty_add(make_rect(x, y, x + w - 1, y + h - 1));
+}
+
+static inline uint16_t *fb_cursor_row(size_t *room) {
+    uint16_t row = g_fb.cursor / g_fb.ww;
+    uint16_t col = g_fb.cursor % g_fb.ww;
+
+    *room = g_fb.ww - col;
+    return &g_fb.buffer[(uint32_t)(g_fb.wy + row) * g_fb.width + g_fb.wx + col];
+}
+
+static void fb_write(void *ctx, const uint16_t *pixels, size_t count) {
+    (void)ctx;
+    while (count > 0) {
+        size_t room;
+        uint16_t *dst = fb_cursor_row(&room);
+        size_t n = count < room ? count : room;
+
+        for (size_t i = 0; i < n; i++) dst[i] = pixels[i];
+        pixels += n;
+        count -= n;
+        g_fb.cursor += n;
+    }
+}
+
+static void fb_repeat(void *ctx, uint16_t color, size_t count) {
+    (void)ctx;
+    while (count > 0) {
+        size_t room;
+        uint16_t *dst = fb_cursor_row(&room);
+        size_t n = count < room ? count : room;
+
+        for (size_t i = 0; i < n; i++) dst[i] = color;
+        count -= n;
+        g_fb.cursor += n;
+    }
+}
+
+static void fb_end(void *ctx) {
+    (void)ctx;
+}
+
+static const ili9341_target_t fb_target = {
+    .pixel = fb_pixel,
+    .window = fb_window,
+    .write = fb_write,
+    .repeat = fb_repeat,
+    .end = fb_end,
+};
+
+// Public API
+
+bool ili9341_fb_begin(uint16_t *buffer, size_t pixels) {
+    if (pixels < (size_t)ili9341_width() * ili9341_height()) return false;
+    
+    g_fb.buffer = buffer;
+    g_fb.width = ili9341_width();
+    g_fb.height = ili9341_height();
+    g_fb.dirty_count = 0;
+    ili9341_set_target(&fb_target, NULL);
+    return true;
+}
+
+void ili9341_fb_end(void) {
+    ili9341_flush();
+    ili9341_set_target(NULL, NULL);
+}
+
+void ili9341_flush(void) {
+    const ili9341_target_t *panel = &ili9341_panel_target;
+    ili9341_display_t *display = ili9341_display_current();
+
+    for (int i = 0; i < g_fb.dirty_count; i++) {
+        const fb_rect_t *r = &g_fb.dirty[i];
+        uint16_t w = r->x1 - r->x0 + 1;
+        uint16_t h = r->y1 - r->y0 + 1;
+        const uint16_t *src = &g_fb.buffer[(uint32_t)r->y0 * g_fb.width + r->x0];
+
+        // One window per region; full-width regions are contiguous in RAM
+        panel->window(display, r->x0, r->y0, w, h);
+        if (w == g_fb.width) {
+            panel->write(display, src, (uint32_t)w * h);
+        } else {
+            for (uint16_t row = 0; row < h; row++) {
+                panel->write(display, src + (uint32_t)row * g_fb.width, w);
+            }
+        }
+        panel->end(display);
+    }
+    g_fb.dirty_count = 0;
+}
+
+void ili9341_fb_mark_dirty(uint16_t x, uint16_t y, uint16_t w, uint16_t h) {
+    if (w == 0 || h == 0 || x >= g_fb.width || y >= g_fb.height) return;
+    if (x + w > g_fb.width) w = g_fb.width - x;
+    if (y + h > g_fb.height) h = g_fb.height - y;
+
+    dirty_add(make_rect(x, y, x + w - 1, y + h - 1));
+}
+
+void ili9341_fb_invalidate(void) {
+    g_fb.dirty_count = 0;
+    dirty_add(make_rect(0, 0, g_fb.width - 1, g_fb.height - 1));
+}
+
+uint16_t *ili9341_fb_buffer(void) {
+    return g_fb.buffer;
+}
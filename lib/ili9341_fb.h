@@ -0,0 +1,47 @@
+#ifndef ILI9341_FB_H
+#define ILI9341_FB_H
+
+#include "ili9341.h"
+
+// Full-screen RAM framebuffer
+//
+// While the framebuffer is active every drawing primitive renders into a
+// caller-supplied buffer of ili9341_width() * ili9341_height() pixels
+// instead of the panel, and the touched areas are recorded as dirty
+// rectangles. That is ILI9341_WIDTH * ILI9341_HEIGHT (150 KB) for one
+// panel, and up to ILI9341_MAX_WIDTH * ILI9341_HEIGHT on a canvas.
+// ili9341_flush() pushes only those areas, merged into as few windows as
+// the rectangle budget allows.
+
+// Dirty rectangles kept between flushes. When the list is full the pair
+// whose union wastes the fewest pixels is merged.
+#ifndef ILI9341_FB_MAX_DIRTY
+#define ILI9341_FB_MAX_DIRTY 16
+#endif
+
+// Two rectangles are merged when their union costs at most this many extra
+// pixels, roughly what one more CASET/PASET/RAMWR window costs on the wire.
+#ifndef ILI9341_FB_MERGE_SLACK
+#define ILI9341_FB_MERGE_SLACK 64
+#endif
+
+// Start rendering into buffer, which holds pixels pixels. The buffer is
+// assumed to match the panel, so nothing is dirty until something is
+// drawn. Rows are laid out at the width of the rotation current here.
+// Returns false, staying in immediate mode, if the buffer is smaller than
+// the screen.
+bool ili9341_fb_begin(uint16_t *buffer, size_t pixels);
+
+// Flush, then return to immediate mode
+void ili9341_fb_end(void);
+
+// Push the dirty regions to the panel and clear the list
+void ili9341_flush(void);
+
+// Mark a region, or the whole screen, as needing a flush
+void ili9341_fb_mark_dirty(uint16_t x, uint16_t y, uint16_t w, uint16_t h);
+void ili9341_fb_invalidate(void);
+
+uint16_t *ili9341_fb_buffer(void);
+
+#endif // ILI9341_FB_H
@@ -0,0 +1,99 @@
+#ifndef ILI9341_HOST_H
+#define ILI9341_HOST_H
+
+#include "ili9341.h"
+#include <pthread.h>
+
+// Host transport
+//
+// Build the library with -DILI9341_HOST and point config->transport at
+// ili9341_host_transport with an ili9341_host_t as its context. Nothing is
+// sent anywhere: the backend counts bytes, CS assertions and DC toggles,
+// optionally logs every bus event, and optionally emulates the panel's GRAM
+// so rendered output can be compared pixel for pixel.
+//
+// The scroll registers are tracked too, and ili9341_host_scanout() composes
+// what the panel would show from GRAM.
+//
+// Asynchronous transfers are completed on a worker thread, which sleeps
+// async_delay_us before emitting each transfer so callers can observe the
+// queue while it is busy.
+
+typedef enum {
+    ILI9341_HOST_EV_SELECT = 0,     // CS asserted
+    ILI9341_HOST_EV_RELEASE,        // CS released
+    ILI9341_HOST_EV_DC,             // DC changed, value = new level
+    ILI9341_HOST_EV_COMMAND,        // Byte sent with DC low
+    ILI9341_HOST_EV_DATA,           // Byte sent with DC high
+} ili9341_host_event_type_t;
+
+typedef struct {
+    uint8_t type;
+    uint8_t value;
+} ili9341_host_event_t;
+
+typedef struct {
+    // Optional event log, recording stops silently once it is full
+    ili9341_host_event_t *log;
+    size_t log_capacity;
+    size_t log_length;
+
+    // Optional emulated GRAM, ILI9341_WIDTH * ILI9341_HEIGHT pixels, as
+    // the screen shows in ILI9341_ROTATION_0 whatever MADCTL is set to
+    uint16_t *gram;
+
+    // Simulated wire time for each asynchronous transfer
+    uint32_t async_delay_us;
+
+    // Wire counters
+    uint64_t bytes;             // Every byte clocked out
+    uint64_t command_bytes;     // Bytes sent with DC low
+    uint64_t transactions;      // CS assertions
+    uint64_t dc_toggles;        // DC level changes
+    uint64_t delay_ms;          // Time the driver asked to sleep
+    uint64_t caset;             // Address window commands, to see what
+    uint64_t paset;             // the driver's window cache elides
+    uint64_t ramwr;
+
+    // Bus and controller state, managed by the backend
+    bool selected;
+    bool dc_data;
+    uint8_t command;
+    uint8_t param_count;
+    uint8_t params[6];
+    bool ram_write;
+    bool high_byte_pending;
+    uint8_t high_byte;
+    uint16_t col_start, col_end;
+    uint16_t page_start, page_end;
+    uint16_t col, page;
+    uint8_t madctl;
+    uint16_t scroll_top, scroll_area, scroll_bottom;   // VSCRDEF
+    uint16_t scroll_start;                              // VSCRSADD
+
+    // Asynchronous worker, started by the first transfer
+    pthread_mutex_t lock;           // Driver critical section
+    pthread_mutex_t worker_lock;
+    pthread_cond_t worker_cond;
+    pthread_t worker;
+    bool worker_started;
+    bool job_pending;
+    const void *job_src;
+    uint8_t job_kind;
+    size_t job_count;
+    void (*job_done)(void *arg);
+    void *job_arg;
+    uint64_t async_transfers;
+} ili9341_host_t;
+
+extern const ili9341_transport_t ili9341_host_transport;
+
+// Copy the image on screen into out (ILI9341_WIDTH * ILI9341_HEIGHT
+// pixels): GRAM with the scroll area rotated to start at scroll_start.
+// Needs gram.
+void ili9341_host_scanout(const ili9341_host_t *host, uint16_t *out);
+
+// Zero the wire counters and the event log, keeping GRAM and bus state
+void ili9341_host_reset_counters(ili9341_host_t *host);
+
+#endif // ILI9341_HOST_H
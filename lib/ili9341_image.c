@@ -0,0 +1,138 @@
+#include "ili9341_image.h"
+#include <string.h>
+
+// At least one row of the widest screen
+#define BLOCK_PIXELS ((uint32_t)ILI9341_WIDTH * ILI9341_IMAGE_ROWS > ILI9341_MAX_WIDTH ? \
+                      (uint32_t)ILI9341_WIDTH * ILI9341_IMAGE_ROWS : ILI9341_MAX_WIDTH)
+
+typedef struct {
+    uint16_t pixels[BLOCK_PIXELS];
+    volatile bool busy;             // Still being streamed to the panel
+} image_block_t;
+
+static image_block_t g_blocks[2];
+
+typedef struct {
+    const uint8_t *in;
+    const uint8_t *end;
+    uint16_t prev;
+    uint16_t run;                   // Repeats of prev still to emit
+    uint16_t recent[64];
+} decoder_t;
+
+static inline uint8_t recent_slot(uint16_t p) {
+    return ((p >> 11) * 3 + ((p >> 5) & 0x3F) * 5 + (p & 0x1F) * 7) % 64;
+}
+
+static inline uint16_t pack(int r, int g, int b) {
+    return ((r & 0x1F) << 11) | ((g & 0x3F) << 5) | (b & 0x1F);
+}
+
+static uint16_t decode_pixel(decoder_t *d) {
+    if (d->run) {
+        d->run--;
+        return d->prev;
+    }
+    // Truncated data repeats the last pixel rather than reading past the end
+    if (d->in >= d->end) return d->prev;
+
+    uint8_t op = *d->in++;
+    int r = d->prev >> 11, g = (d->prev >> 5) & 0x3F, b = d->prev & 0x1F;
+    uint16_t p;
+
+    if (op == 0xFE) {
+        if (d->end - d->in < 2) return d->prev;
+        p = ((uint16_t)d->in[0] << 8) | d->in[1];
+        d->in += 2;
+    } else if (op == 0xFF) {
+        if (d->in >= d->end) return d->prev;
+        d->run = *d->in++ + 62;
+        return d->prev;
+    } else {
+        switch (op >> 6) {
+            case 0:
+                p = d->recent[op];
+                break;
+            case 1:
+                p = pack(r + ((op >> 4) & 3) - 2, g + ((op >> 2) & 3) - 2, b + (op & 3) - 2);
+                break;
+            case 2: {
+                if (d->in >= d->end) return d->prev;
+                int dg = (op & 0x3F) - 32;
+                int half = (dg + 32) / 2 - 16;      // floor(dg / 2)
+                uint8_t rb = *d->in++;
+                p = pack(r + half + (rb >> 4) - 8, g + dg, b + half + (rb & 0x0F) - 8);
+                break;
+            }
+            default:
+                d->run = op & 0x3F;
+                return d->prev;
+        }
+    }
+
+    d->recent[recent_slot(p)] = p;
+    d->prev = p;
+    return p;
+}
+
+static void block_sent(void *user) {
+    ((image_block_t *)user)->busy = false;
+}
+
+static void image_op_draw(ili9341_display_t *display, const ili9341_op_t *op) {
+    ili9341_draw_image_on(display, op->x, op->y, (const ili9341_image_t *)op->data);
+}
+
+void ili9341_draw_image(int16_t x, int16_t y, const ili9341_image_t *image) {
+    ili9341_draw_image_on(ili9341_display_current(), x, y, image);
+}
+
+void ili9341_draw_image_on(ili9341_display_t *display, int16_t x, int16_t y, const ili9341_image_t *image) {
+    ili9341_op_t op = { .type = ILI9341_OP_CUSTOM, .x = x, .y = y, .w = image->width,
+                        .h = image->height, .data = image, .draw = image_op_draw };
+    if (ili9341_capture_on(display, &op)) return;
+
+    // Cut to the clip. Rows above it and columns either side are decoded
+    // and dropped; decoding stops at its bottom edge.
+    ili9341_span_t clip;
+    ili9341_clip_get_on(display, &clip);
+    int32_t x0 = x > clip.x ? x : clip.x;
+    int32_t y0 = y > clip.y ? y : clip.y;
+    int32_t x1 = (int32_t)x + image->width < clip.x + clip.w ? (int32_t)x + image->width : clip.x + clip.w;
+    int32_t y1 = (int32_t)y + image->height < clip.y + clip.h ? (int32_t)y + image->height : clip.y + clip.h;
+    if (x0 >= x1 || y0 >= y1) return;
+
+    uint16_t cw = x1 - x0, ch = y1 - y0;
+    uint16_t skip = x0 - x;
+
+    decoder_t d = { .in = image->data, .end = image->data + image->size };
+    memset(d.recent, 0, sizeof(d.recent));
+    for (uint32_t i = (uint32_t)(y0 - y) * image->width; i > 0; i--) {
+        decode_pixel(&d);
+    }
+
+    // Fewer rows per block on a canvas wider than a panel
+    uint16_t block_rows = BLOCK_PIXELS / cw < ILI9341_IMAGE_ROWS ? BLOCK_PIXELS / cw : ILI9341_IMAGE_ROWS;
+
+    uint8_t next = 0;
+    for (uint16_t row = 0; row < ch; row += block_rows) {
+        image_block_t *block = &g_blocks[next];
+        uint16_t rows = ch - row < block_rows ? ch - row : block_rows;
+
+        // The other block keeps streaming while this one decodes
+        while (block->busy) {
+        }
+
+        uint16_t *dst = block->pixels;
+        for (uint16_t r = 0; r < rows; r++) {
+            for (uint16_t col = 0; col < image->width; col++) {
+                uint16_t p = decode_pixel(&d);
+                if (col >= skip && col - skip < cw) *dst++ = p;
+            }
+        }
+
+        block->busy = true;
+        ili9341_draw_bitmap_async_on(display, x0, y0 + row, cw, rows, block->pixels, block_sent, block);
+        next ^= 1;
+    }
+}
@@ -0,0 +1,43 @@
+#ifndef ILI9341_IMAGE_H
+#define ILI9341_IMAGE_H
+
+#include "ili9341.h"
+
+// Compressed images
+//
+// image_converter.py --compressed encodes RGB565 images in a QOI-style
+// byte stream. Each op is one of:
+//
+//   00iiiiii              Pixel from slot i of the 64-entry recent table
+//   01rrggbb              Previous pixel plus dr, dg, db in -2..1
+//   10gggggg rrrrbbbb     dg in -32..31, dr and db within -8..7 of dg / 2
+//   11nnnnnn              Previous pixel repeated n + 1 times (1..62)
+//   11111110 hi lo        Raw pixel, big-endian
+//   11111111 n            Previous pixel repeated n + 63 times (63..318)
+//
+// The previous pixel starts out black, and every decoded pixel is stored
+// in slot (r * 3 + g * 5 + b * 7) % 64 of the table (5/6/5-bit channels).
+// Flat UI backgrounds shrink to a few percent of their raw size.
+//
+// The decoder expands ILI9341_IMAGE_ROWS rows at a time into one of two
+// small buffers and streams each block with ili9341_draw_bitmap_async()
+// while it decodes the next.
+#ifndef ILI9341_IMAGE_ROWS
+#define ILI9341_IMAGE_ROWS 4
+#endif
+
+typedef struct {
+    uint16_t width;
+    uint16_t height;
+    uint32_t size;          // Bytes in data
+    const uint8_t *data;
+} ili9341_image_t;
+
+// Draw a compressed image, clipped like the other primitives. The
+// descriptor and data must stay valid while the image is recorded in a
+// display list. Both block buffers are shared, so images are drawn from
+// one core at a time, whichever display they go to.
+void ili9341_draw_image(int16_t x, int16_t y, const ili9341_image_t *image);
+void ili9341_draw_image_on(ili9341_display_t *display, int16_t x, int16_t y, const ili9341_image_t *image);
+
+#endif // ILI9341_IMAGE_H
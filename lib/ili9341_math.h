@@ -0,0 +1,33 @@
+#ifndef ILI9341_MATH_H
+#define ILI9341_MATH_H
+
+#include <stdint.h>
+
+// Fixed-point trigonometry for FPU-less targets
+//
+// Angles are 1/65536 of a turn, measured on screen from the positive x axis
+// (3 o'clock) towards positive y, so they increase clockwise. Only the low 16
+// bits matter: any int32_t angle wraps correctly. Sines and cosines are Q15,
+// with 1.0 = ILI9341_Q15_ONE (32768, so returned as int32_t).
+//
+// sin/cos interpolate a 257-entry quarter-wave table (within about 1 LSB);
+// atan2 reduces to one octant and interpolates a 257-entry arctangent
+// table (within 1.5 angle units, 0.01 degrees). No libm, no floating point.
+
+#define ILI9341_ANGLE_TURN 65536
+#define ILI9341_Q15_ONE 32768
+
+// Whole degrees to angle units, usable in constant expressions
+#define ILI9341_DEG(d) ((int32_t)((int64_t)(d) * ILI9341_ANGLE_TURN / 360))
+
+int32_t ili9341_sin(int32_t angle);
+int32_t ili9341_cos(int32_t angle);
+
+// Angle of the vector (x, y) in -32768..32767, 0 for the zero vector
+int32_t ili9341_atan2(int32_t y, int32_t x);
+
+// Point at distance r (pixels) and angle from (cx, cy), rounded to the
+// nearest pixel
+void ili9341_polar(int32_t cx, int32_t cy, int32_t r, int32_t angle, int32_t *x, int32_t *y);
+
+#endif // ILI9341_MATH_H
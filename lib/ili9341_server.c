@@ -0,0 +1,316 @@
+#include "ili9341_server.h"
+#include <string.h>
+
+#ifndef ILI9341_HOST
+#include "pico/multicore.h"
+#include "hardware/sync.h"
+#endif
+
+#define RING_MASK (ILI9341_SERVER_RING - 1)
+
+// Records start on 8-byte boundaries. A record never straddles the end of
+// the ring: when it would, a WRAP record pads out the rest and it starts
+// again at offset 0.
+#define RECORD_ALIGN 8
+
+// Largest payload in one record, so any record fits a half-empty ring
+#define MAX_PAYLOAD (ILI9341_SERVER_RING / 4)
+
+enum {
+    OP_WRAP,
+    OP_INIT,
+    OP_RESET,
+    OP_DELAY,
+    OP_BEGIN,
+    OP_END,
+    OP_COMMAND,
+    OP_DATA,
+    OP_PIXELS,
+    OP_FILL,
+};
+
+// Header of each record, followed by the payload for DATA and PIXELS
+typedef struct {
+    uint8_t op;
+    uint8_t cmd;
+    uint16_t color;
+    uint32_t count;     // Bytes, pixels or milliseconds
+} record_t;
+
+static inline uint32_t align_up(uint32_t n) {
+    return (n + RECORD_ALIGN - 1) & ~(uint32_t)(RECORD_ALIGN - 1);
+}
+
+static uint32_t record_size(const record_t *r) {
+    switch (r->op) {
+        case OP_DATA: return align_up(sizeof(record_t) + r->count);
+        case OP_PIXELS: return align_up(sizeof(record_t) + r->count * 2);
+        default: return sizeof(record_t);
+    }
+}
+
+// Waking the other side. The caller reads the wake count, checks the ring,
+// and only then sleeps, so a wake-up in between is not lost. On the Pico
+// the event register latches SEV, which gives the same guarantee.
+
+#ifdef ILI9341_HOST
+static uint32_t wake_count(ili9341_server_t *server) {
+    pthread_mutex_lock(&server->wake_lock);
+    uint32_t count = server->wake_count;
+    pthread_mutex_unlock(&server->wake_lock);
+    return count;
+}
+
+static void wait_wake(ili9341_server_t *server, uint32_t seen) {
+    pthread_mutex_lock(&server->wake_lock);
+    while (server->wake_count == seen) {
+        pthread_cond_wait(&server->wake, &server->wake_lock);
+    }
+    pthread_mutex_unlock(&server->wake_lock);
+}
+
+static void signal_wake(ili9341_server_t *server) {
+    pthread_mutex_lock(&server->wake_lock);
+    server->wake_count++;
+    pthread_cond_broadcast(&server->wake);
+    pthread_mutex_unlock(&server->wake_lock);
+}
+#else
+static inline uint32_t wake_count(ili9341_server_t *server) {
+    (void)server;
+    return 0;
+}
+
+static inline void wait_wake(ili9341_server_t *server, uint32_t seen) {
+    (void)server;
+    (void)seen;
+    __wfe();
+}
+
+static inline void signal_wake(ili9341_server_t *server) {
+    (void)server;
+    __sev();
+}
+#endif
+
+// Server side: replay records in order, releasing each one's space as soon
+// as it has been sent
+
+static void server_execute(ili9341_server_t *server, const record_t *r) {
+    const ili9341_transport_t *t = server->transport;
+    void *ctx = server->transport_ctx;
+    const void *payload = r + 1;
+
+    switch (r->op) {
+        case OP_INIT: t->init(ctx); break;
+        case OP_RESET: t->reset(ctx); break;
+        case OP_DELAY: t->delay_ms(ctx, r->count); break;
+        case OP_BEGIN: t->begin(ctx); break;
+        case OP_END: t->end(ctx); break;
+        case OP_COMMAND: t->write_command(ctx, r->cmd); break;
+        case OP_DATA: t->write_data(ctx, payload, r->count); break;
+        case OP_PIXELS: t->write_pixels(ctx, payload, r->count); break;
+        case OP_FILL: t->fill_pixels(ctx, r->color, r->count); break;
+    }
+}
+
+static void server_loop(ili9341_server_t *server) {
+    uint32_t tail = atomic_load_explicit(&server->tail, memory_order_relaxed);
+
+    for (;;) {
+        uint32_t seen = wake_count(server);
+        uint32_t head = atomic_load_explicit(&server->head, memory_order_acquire);
+        if (head == tail) {
+            wait_wake(server, seen);
+            continue;
+        }
+
+        while (tail != head) {
+            uint32_t pos = tail & RING_MASK;
+            const record_t *r = (const record_t *)&server->ring[pos];
+
+            if (r->op == OP_WRAP) {
+                tail += ILI9341_SERVER_RING - pos;
+            } else {
+                server_execute(server, r);
+                tail += record_size(r);
+            }
+            atomic_store_explicit(&server->tail, tail, memory_order_release);
+            signal_wake(server);
+        }
+    }
+}
+
+#ifdef ILI9341_HOST
+static void *server_thread(void *arg) {
+    server_loop(arg);
+    return NULL;
+}
+
+static void server_start(ili9341_server_t *server) {
+    pthread_create(&server->thread, NULL, server_thread, server);
+    pthread_detach(server->thread);
+}
+#else
+// Core1 takes the server from the multicore FIFO and never returns
+static void server_core1_entry(void) {
+    server_loop((ili9341_server_t *)(uintptr_t)multicore_fifo_pop_blocking());
+}
+
+static void server_start(ili9341_server_t *server) {
+    multicore_launch_core1(server_core1_entry);
+    multicore_fifo_push_blocking((uint32_t)(uintptr_t)server);
+}
+#endif
+
+// Producer side
+
+// Find contiguous room for a record of size bytes, waiting for the server
+// if the ring is too full. Returns where to build the record; *advance is
+// what to add to head when publishing it, wrap padding included.
+static record_t *server_reserve(ili9341_server_t *server, uint32_t size, uint32_t *advance) {
+    uint32_t head = atomic_load_explicit(&server->head, memory_order_relaxed);
+    uint32_t pos = head & RING_MASK;
+    uint32_t skip = (pos + size > ILI9341_SERVER_RING) ? ILI9341_SERVER_RING - pos : 0;
+    uint32_t need = skip + size;
+
+    if (ILI9341_SERVER_RING - (head - atomic_load_explicit(&server->tail, memory_order_acquire)) < need) {
+        server->stalls++;
+        for (;;) {
+            uint32_t seen = wake_count(server);
+            uint32_t tail = atomic_load_explicit(&server->tail, memory_order_acquire);
+            if (ILI9341_SERVER_RING - (head - tail) >= need) break;
+            wait_wake(server, seen);
+        }
+    }
+
+    if (skip) {
+        ((record_t *)&server->ring[pos])->op = OP_WRAP;
+        pos = 0;
+    }
+    *advance = need;
+    return (record_t *)&server->ring[pos];
+}
+
+static void server_publish(ili9341_server_t *server, uint32_t advance) {
+    uint32_t head = atomic_load_explicit(&server->head, memory_order_relaxed) + advance;
+    uint32_t queued = head - atomic_load_explicit(&server->tail, memory_order_relaxed);
+
+    if (queued > server->high_water) server->high_water = queued;
+    atomic_store_explicit(&server->head, head, memory_order_release);
+    signal_wake(server);
+}
+
+static void server_post(ili9341_server_t *server, uint8_t op, uint8_t cmd, uint16_t color, uint32_t count,
+                        const void *payload, uint32_t payload_bytes) {
+    uint32_t advance;
+    record_t *r = server_reserve(server, align_up(sizeof(record_t) + payload_bytes), &advance);
+
+    r->op = op;
+    r->cmd = cmd;
+    r->color = color;
+    r->count = count;
+    if (payload_bytes) memcpy(r + 1, payload, payload_bytes);
+    server_publish(server, advance);
+}
+
+// Transport hooks
+
+static inline ili9341_server_t *server_state(void *ctx) {
+    return (ili9341_server_t *)ctx;
+}
+
+static void server_init_hook(void *ctx) {
+    ili9341_server_t *server = server_state(ctx);
+
+    if (!server->started) {
+        server_start(server);
+        server->started = true;
+    }
+    server_post(server, OP_INIT, 0, 0, 0, NULL, 0);
+}
+
+static void server_reset(void *ctx) {
+    server_post(server_state(ctx), OP_RESET, 0, 0, 0, NULL, 0);
+}
+
+static void server_delay_ms(void *ctx, uint32_t ms) {
+    server_post(server_state(ctx), OP_DELAY, 0, 0, ms, NULL, 0);
+}
+
+static void server_begin(void *ctx) {
+    server_post(server_state(ctx), OP_BEGIN, 0, 0, 0, NULL, 0);
+}
+
+static void server_end(void *ctx) {
+    server_post(server_state(ctx), OP_END, 0, 0, 0, NULL, 0);
+}
+
+static void server_write_command(void *ctx, uint8_t cmd) {
+    server_post(server_state(ctx), OP_COMMAND, cmd, 0, 0, NULL, 0);
+}
+
+static void server_write_data(void *ctx, const uint8_t *data, size_t len) {
+    while (len > 0) {
+        uint32_t n = len < MAX_PAYLOAD ? len : MAX_PAYLOAD;
+        server_post(server_state(ctx), OP_DATA, 0, 0, n, data, n);
+        data += n;
+        len -= n;
+    }
+}
+
+static void server_write_pixels(void *ctx, const uint16_t *pixels, size_t count) {
+    while (count > 0) {
+        uint32_t n = count < MAX_PAYLOAD / 2 ? count : MAX_PAYLOAD / 2;
+        server_post(server_state(ctx), OP_PIXELS, 0, 0, n, pixels, n * 2);
+        pixels += n;
+        count -= n;
+    }
+}
+
+static void server_fill_pixels(void *ctx, uint16_t color, size_t count) {
+    server_post(server_state(ctx), OP_FILL, 0, color, count, NULL, 0);
+}
+
+const ili9341_transport_t ili9341_server_transport = {
+    .init = server_init_hook,
+    .reset = server_reset,
+    .delay_ms = server_delay_ms,
+    .begin = server_begin,
+    .end = server_end,
+    .write_command = server_write_command,
+    .write_data = server_write_data,
+    .write_pixels = server_write_pixels,
+    .fill_pixels = server_fill_pixels,
+};
+
+void ili9341_server_init(ili9341_server_t *server, const ili9341_transport_t *transport, void *ctx) {
+    server->transport = transport;
+    server->transport_ctx = ctx;
+    atomic_init(&server->head, 0);
+    atomic_init(&server->tail, 0);
+    server->stalls = 0;
+    server->high_water = 0;
+    server->started = false;
+
+#ifdef ILI9341_HOST
+    pthread_mutex_init(&server->wake_lock, NULL);
+    pthread_cond_init(&server->wake, NULL);
+    server->wake_count = 0;
+#endif
+}
+
+void ili9341_server_sync(ili9341_server_t *server) {
+    uint32_t head = atomic_load_explicit(&server->head, memory_order_relaxed);
+
+    for (;;) {
+        uint32_t seen = wake_count(server);
+        if (atomic_load_explicit(&server->tail, memory_order_acquire) == head) return;
+        wait_wake(server, seen);
+    }
+}
+
+uint32_t ili9341_server_pending(const ili9341_server_t *server) {
+    return atomic_load_explicit(&server->head, memory_order_relaxed) -
+           atomic_load_explicit(&server->tail, memory_order_relaxed);
+}
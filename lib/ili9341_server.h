@@ -0,0 +1,73 @@
+#ifndef ILI9341_SERVER_H
+#define ILI9341_SERVER_H
+
+#include "ili9341.h"
+#include <stdatomic.h>
+#ifdef ILI9341_HOST
+#include <pthread.h>
+#endif
+
+// Display server
+//
+// A transport that hands the bus to a second core. Every transport call
+// made by the driver (commands, window setup, pixel data, fills, delays)
+// is appended to a single-producer single-consumer ring and returns at
+// once; core1 (a pthread on the host) owns the real transport and replays
+// the ring in order. Drawing on core0 then costs a copy into RAM instead
+// of the time on the wire, so application work overlaps display I/O.
+//
+// Pixel and byte data are copied into the ring, so callers may reuse their
+// buffers as soon as a call returns. Fills and commands are a few bytes.
+// When the ring is full the producer waits for core1 to catch up.
+//
+//     static ili9341_server_t server;
+//     ili9341_server_init(&server, &ili9341_pico_transport, &config);
+//     config.transport = &ili9341_server_transport;
+//     config.transport_ctx = &server;
+//     ili9341_init(&config);          // Starts core1
+//
+// The server transport has no DMA hooks: the *_async calls run through the
+// ring like everything else and call back once their data is queued. The
+// Pico build needs pico_multicore; core1 is reserved for the server.
+
+// Ring size in bytes, a power of two. Larger pixel writes are split.
+#ifndef ILI9341_SERVER_RING
+#define ILI9341_SERVER_RING 8192
+#endif
+
+typedef struct {
+    const ili9341_transport_t *transport;   // Backend driven by the server
+    void *transport_ctx;
+
+    // Free-running byte offsets; the producer only writes head, the
+    // server only writes tail
+    _Atomic uint32_t head;
+    _Atomic uint32_t tail;
+
+    uint32_t stalls;                        // Producer waits on a full ring
+    uint32_t high_water;                    // Most bytes queued at once
+    bool started;
+
+#ifdef ILI9341_HOST
+    pthread_mutex_t wake_lock;
+    pthread_cond_t wake;
+    uint32_t wake_count;
+    pthread_t thread;
+#endif
+
+    _Alignas(8) uint8_t ring[ILI9341_SERVER_RING];
+} ili9341_server_t;
+
+extern const ili9341_transport_t ili9341_server_transport;
+
+// Prepare a server for the given backend. Pass the server and
+// ili9341_server_transport to ili9341_init(), which starts it.
+void ili9341_server_init(ili9341_server_t *server, const ili9341_transport_t *transport, void *ctx);
+
+// Wait until everything queued so far is on the wire
+void ili9341_server_sync(ili9341_server_t *server);
+
+// Bytes queued and not yet sent
+uint32_t ili9341_server_pending(const ili9341_server_t *server);
+
+#endif // ILI9341_SERVER_H
@@ -0,0 +1,149 @@
+#include "ili9341_strip.h"
+#include <string.h>
+
+// At least one row of the widest screen
+#define STRIP_PIXELS ((uint32_t)ILI9341_WIDTH * ILI9341_STRIP_HEIGHT > ILI9341_MAX_WIDTH ? \
+                      (uint32_t)ILI9341_WIDTH * ILI9341_STRIP_HEIGHT : ILI9341_MAX_WIDTH)
+
+typedef struct {
+    uint16_t pixels[STRIP_PIXELS];
+    uint16_t top, height;           // Screen rows held by the buffer
+    uint16_t width;                 // Row stride, the screen width
+    volatile bool busy;             // Still being streamed to the panel
+
+    // Window being streamed by the target
+    uint16_t wx, wy, ww;
+    uint32_t cursor;
+} strip_t;
+
+static strip_t g_strips[2];
+
+static ili9341_dlist_t g_frame;
+static uint16_t g_background;
+
+// Render target, clips everything to the strip's rows
+
+static void strip_pixel(void *ctx, uint16_t x, uint16_t y, uint16_t color) {
+    strip_t *s = (strip_t *)ctx;
+    if (y < s->top || y >= s->top + s->height) return;
+
+    s->pixels[(uint32_t)(y - s->top) * s->width + x] = color;
+}
+
+static void strip_window(void *ctx, uint16_t x, uint16_t y, uint16_t w, uint16_t h) {
+    strip_t *s = (strip_t *)ctx;
+    (void)h;
+
+    s->wx = x;
+    s->wy = y;
+    s->ww = w;
+    s->cursor = 0;
+}
+
+// Walk count pixels from the cursor, handing each run that falls inside the
+// strip to copy() and skipping the rest a row (or a whole band) at a time
+static void strip_stream(strip_t *s, size_t count, const uint16_t *pixels, uint16_t color) {
+    while (count > 0) {
+        uint16_t y = s->wy + s->cursor / s->ww;
+        uint16_t col = s->cursor % s->ww;
+        size_t n;
+
+        if (y >= s->top + s->height) {
+            // The rest of the window lies below the strip
+            s->cursor += count;
+            return;
+        }
+        if (y < s->top) {
+            n = (uint32_t)(s->top - y) * s->ww - col;
+            if (n > count) n = count;
+        } else {
+            uint16_t *dst = &s->pixels[(uint32_t)(y - s->top) * s->width + s->wx + col];
+            n = s->ww - col;
+            if (n > count) n = count;
+            if (pixels) {
+                memcpy(dst, pixels, n * sizeof(uint16_t));
+            } else {
+                for (size_t i = 0; i < n; i++) dst[i] = color;
+            }
+        }
+        if (pixels) pixels += n;
+        count -= n;
+        s->cursor += n;
+    }
+}
+
+static void strip_write(void *ctx, const uint16_t *pixels, size_t count) {
+    strip_stream((strip_t *)ctx, count, pixels, 0);
+}
+
+static void strip_repeat(void *ctx, uint16_t color, size_t count) {
+    strip_stream((strip_t *)ctx, count, NULL, color);
+}
+
+static void strip_end(void *ctx) {
+    (void)ctx;
+}
+
+static const ili9341_target_t strip_target = {
+    .pixel = strip_pixel,
+    .window = strip_window,
+    .write = strip_write,
+    .repeat = strip_repeat,
+    .end = strip_end,
+};
+
+static void strip_sent(void *user) {
+    ((strip_t *)user)->busy = false;
+}
+
+// Public API
+
+void ili9341_strip_begin(void *arena, size_t size, uint16_t background) {
+    ili9341_dlist_init(&g_frame, arena, size);
+    g_background = background;
+    ili9341_dlist_begin(&g_frame);
+}
+
+bool ili9341_strip_end(void) {
+    ili9341_dlist_end();
+    ili9341_strip_render(&g_frame, g_background);
+    return !g_frame.overflow;
+}
+
+void ili9341_strip_render(const ili9341_dlist_t *list, uint16_t background) {
+    uint16_t width = ili9341_width();
+    uint16_t screen_height = ili9341_height();
+    uint16_t rows = STRIP_PIXELS / width;       // Fewer on a canvas wider than a panel
+    uint8_t next = 0;
+
+    if (rows > ILI9341_STRIP_HEIGHT) rows = ILI9341_STRIP_HEIGHT;
+    for (uint16_t top = 0; top < screen_height; top += rows) {
+        strip_t *s = &g_strips[next];
+        uint16_t height = screen_height - top;
+        if (height > rows) height = rows;
+
+        // The other buffer keeps streaming while this one renders
+        while (s->busy) {
+        }
+
+        s->top = top;
+        s->height = height;
+        s->width = width;
+        for (uint32_t i = 0; i < (uint32_t)width * height; i++) {
+            s->pixels[i] = background;
+        }
+
+        // Clipped to the band, the rasterizers skip rows outside it up
+        // front; the target's row checks stay as a safety net for a full
+        // clip stack
+        bool clipped = ili9341_clip_push(0, top, width, height);
+        ili9341_set_target(&strip_target, s);
+        ili9341_dlist_replay_rows(list, top, top + height - 1);
+        ili9341_set_target(NULL, NULL);
+        if (clipped) ili9341_clip_pop();
+
+        s->busy = true;
+        ili9341_draw_bitmap_async(0, top, width, height, s->pixels, strip_sent, s);
+        next ^= 1;
+    }
+}
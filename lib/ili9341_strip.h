@@ -0,0 +1,32 @@
+#ifndef ILI9341_STRIP_H
+#define ILI9341_STRIP_H
+
+#include "ili9341_dlist.h"
+
+// Strip renderer
+//
+// For builds that cannot spare a full framebuffer. A frame's primitives are
+// recorded into a display list, then rasterized one full-width strip at a
+// time into one of two strip buffers. Each finished strip is streamed with
+// ili9341_draw_bitmap_async() while the next one renders into the other
+// buffer. Strips start out as the background color, so a frame must redraw
+// everything that is not background.
+//
+// RAM use is 2 * ILI9341_WIDTH * ILI9341_STRIP_HEIGHT * 2 bytes (20 KB at
+// the default height) plus the display list arena. Taller strips mean fewer
+// passes over the display list and fewer windows; shorter ones save RAM.
+#ifndef ILI9341_STRIP_HEIGHT
+#define ILI9341_STRIP_HEIGHT 16
+#endif
+
+// Start recording a frame into arena
+void ili9341_strip_begin(void *arena, size_t size, uint16_t background);
+
+// Stop recording and render the frame. Returns false if the arena
+// overflowed, in which case the ops that did not fit are missing.
+bool ili9341_strip_end(void);
+
+// Render an already recorded list, for example a static screen
+void ili9341_strip_render(const ili9341_dlist_t *list, uint16_t background);
+
+#endif // ILI9341_STRIP_H
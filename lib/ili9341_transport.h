@@ -0,0 +1,52 @@
+#ifndef ILI9341_TRANSPORT_H
+#define ILI9341_TRANSPORT_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Transport vtable
+//
+// The driver never touches SPI or GPIO directly. Everything it sends to the
+// panel goes through one of these hooks, so the same drawing code can run on
+// the Pico SPI peripheral or on a host backend that records the byte stream.
+//
+// A transaction is bracketed by begin()/end() (CS asserted/released). Inside
+// it, write_command() sends one byte with DC low and leaves DC high again, so
+// the data writes that follow need no DC handling of their own.
+typedef struct ili9341_transport {
+    void (*init)(void *ctx);                                   // Bring up bus and control pins
+    void (*reset)(void *ctx);                                  // Pulse the RST line
+    void (*delay_ms)(void *ctx, uint32_t ms);
+
+    void (*begin)(void *ctx);                                  // Assert CS
+    void (*end)(void *ctx);                                    // Release CS
+
+    void (*write_command)(void *ctx, uint8_t cmd);
+    void (*write_data)(void *ctx, const uint8_t *data, size_t len);
+    void (*write_pixels)(void *ctx, const uint16_t *pixels, size_t count);  // RGB565, MSB first on the wire
+    void (*fill_pixels)(void *ctx, uint16_t color, size_t count);           // Same color repeated
+
+    // Optional asynchronous streaming, used by the *_async drawing calls.
+    // All return at once and call done(arg) from interrupt or worker context
+    // once the last bit is on the wire. The source must stay valid until
+    // then; start_fill() re-reads the single color word for every pixel.
+    // lock()/unlock() guard driver state shared with done().
+    void (*start_pixels)(void *ctx, const uint16_t *pixels, size_t count,
+                         void (*done)(void *arg), void *arg);
+    void (*start_fill)(void *ctx, const uint16_t *color, size_t count,
+                       void (*done)(void *arg), void *arg);
+    void (*start_bytes)(void *ctx, const uint8_t *data, size_t len,      // Sent as is
+                        void (*done)(void *arg), void *arg);
+    uint32_t (*lock)(void *ctx);
+    void (*unlock)(void *ctx, uint32_t state);
+} ili9341_transport_t;
+
+#ifndef ILI9341_HOST
+// Pico SPI backend. Its context is the ili9341_config_t passed to
+// ili9341_init(), and it is selected automatically when config->transport
+// is NULL.
+extern const ili9341_transport_t ili9341_pico_transport;
+#endif
+
+#endif // ILI9341_TRANSPORT_H
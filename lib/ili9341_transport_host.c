@@ -0,0 +1,345 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "ili9341_host.h"
+#include <string.h>
+#include <time.h>
+
+// Host transport. The context pointer is an ili9341_host_t.
+
+static inline ili9341_host_t *host_state(void *ctx) {
+    return (ili9341_host_t *)ctx;
+}
+
+static void host_log(ili9341_host_t *host, uint8_t type, uint8_t value) {
+    if (!host->log || host->log_length >= host->log_capacity) return;
+
+    host->log[host->log_length].type = type;
+    host->log[host->log_length].value = value;
+    host->log_length++;
+}
+
+static void host_set_dc(ili9341_host_t *host, bool data) {
+    if (host->dc_data == data) return;
+
+    host->dc_data = data;
+    host->dc_toggles++;
+    host_log(host, ILI9341_HOST_EV_DC, data);
+}
+
+// GRAM emulation
+
+static void gram_command(ili9341_host_t *host, uint8_t cmd) {
+    host->command = cmd;
+    host->param_count = 0;
+    host->high_byte_pending = false;
+    host->ram_write = (cmd == ILI9341_RAMWR);
+
+    switch (cmd) {
+        case ILI9341_CASET: host->caset++; break;
+        case ILI9341_PASET: host->paset++; break;
+        case ILI9341_RAMWR:
+            host->ramwr++;
+            host->col = host->col_start;
+            host->page = host->page_start;
+            break;
+    }
+}
+
+// MADCTL relative to rotation 0: exchange columns and pages, then mirror
+static void gram_store(ili9341_host_t *host, uint16_t color) {
+    uint8_t flip = host->madctl ^ (ILI9341_MADCTL_MY | ILI9341_MADCTL_BGR);
+    uint32_t x = host->col, y = host->page;
+
+    if (host->madctl & ILI9341_MADCTL_MV) {
+        x = host->page;
+        y = host->col;
+    }
+    if (x >= ILI9341_WIDTH || y >= ILI9341_HEIGHT) return;
+    if (flip & ILI9341_MADCTL_MX) x = ILI9341_WIDTH - 1 - x;
+    if (flip & ILI9341_MADCTL_MY) y = ILI9341_HEIGHT - 1 - y;
+
+    host->gram[y * ILI9341_WIDTH + x] = color;
+}
+
+static void gram_pixel(ili9341_host_t *host, uint16_t color) {
+    if (host->gram) gram_store(host, color);
+
+    // Advance in GRAM order, wrapping inside the address window
+    if (host->col < host->col_end) {
+        host->col++;
+        return;
+    }
+    host->col = host->col_start;
+    host->page = (host->page < host->page_end) ? host->page + 1 : host->page_start;
+}
+
+static void gram_data(ili9341_host_t *host, uint8_t data) {
+    if (host->ram_write) {
+        if (!host->high_byte_pending) {
+            host->high_byte = data;
+            host->high_byte_pending = true;
+        } else {
+            host->high_byte_pending = false;
+            gram_pixel(host, ((uint16_t)host->high_byte << 8) | data);
+        }
+        return;
+    }
+
+    uint8_t expected;
+    switch (host->command) {
+        case ILI9341_CASET:
+        case ILI9341_PASET: expected = 4; break;
+        case ILI9341_VSCRDEF: expected = 6; break;
+        case ILI9341_VSCRSADD: expected = 2; break;
+        case ILI9341_MADCTL: expected = 1; break;
+        default: return;
+    }
+    if (host->param_count >= expected) return;
+
+    host->params[host->param_count++] = data;
+    if (host->param_count < expected) return;
+
+    uint16_t first = ((uint16_t)host->params[0] << 8) | host->params[1];
+    uint16_t second = ((uint16_t)host->params[2] << 8) | host->params[3];
+    switch (host->command) {
+        case ILI9341_CASET:
+            host->col_start = first;
+            host->col_end = second;
+            break;
+        case ILI9341_PASET:
+            host->page_start = first;
+            host->page_end = second;
+            break;
+        case ILI9341_VSCRDEF:
+            host->scroll_top = first;
+            host->scroll_area = second;
+            host->scroll_bottom = ((uint16_t)host->params[4] << 8) | host->params[5];
+            break;
+        case ILI9341_VSCRSADD:
+            host->scroll_start = first;
+            break;
+        case ILI9341_MADCTL:
+            host->madctl = host->params[0];
+            break;
+    }
+}
+
+static void host_data_byte(ili9341_host_t *host, uint8_t data) {
+    host->bytes++;
+    host_log(host, ILI9341_HOST_EV_DATA, data);
+    gram_data(host, data);
+}
+
+// Transport hooks
+
+static void host_init(void *ctx) {
+    ili9341_host_t *host = host_state(ctx);
+
+    host->selected = false;
+    host->dc_data = true;
+    host->command = ILI9341_NOP;
+    host->ram_write = false;
+    host->col_start = host->page_start = 0;
+    host->col_end = ILI9341_WIDTH - 1;
+    host->page_end = ILI9341_HEIGHT - 1;
+    host->madctl = ILI9341_MADCTL_MY | ILI9341_MADCTL_BGR;
+    host->scroll_top = host->scroll_bottom = 0;
+    host->scroll_area = ILI9341_HEIGHT;
+    host->scroll_start = 0;
+
+    pthread_mutex_init(&host->lock, NULL);
+    pthread_mutex_init(&host->worker_lock, NULL);
+    pthread_cond_init(&host->worker_cond, NULL);
+    host->worker_started = false;
+    host->job_pending = false;
+}
+
+static void host_reset(void *ctx) {
+    host_state(ctx)->delay_ms += 175;
+}
+
+static void host_delay_ms(void *ctx, uint32_t ms) {
+    host_state(ctx)->delay_ms += ms;
+}
+
+static void host_begin(void *ctx) {
+    ili9341_host_t *host = host_state(ctx);
+
+    host->selected = true;
+    host->transactions++;
+    host_log(host, ILI9341_HOST_EV_SELECT, 0);
+}
+
+static void host_end(void *ctx) {
+    ili9341_host_t *host = host_state(ctx);
+
+    host->selected = false;
+    host_log(host, ILI9341_HOST_EV_RELEASE, 0);
+}
+
+static void host_write_command(void *ctx, uint8_t cmd) {
+    ili9341_host_t *host = host_state(ctx);
+
+    host_set_dc(host, false);
+    host->bytes++;
+    host->command_bytes++;
+    host_log(host, ILI9341_HOST_EV_COMMAND, cmd);
+    gram_command(host, cmd);
+    host_set_dc(host, true);
+}
+
+static void host_write_data(void *ctx, const uint8_t *data, size_t len) {
+    ili9341_host_t *host = host_state(ctx);
+
+    for (size_t i = 0; i < len; i++) {
+        host_data_byte(host, data[i]);
+    }
+}
+
+static void host_write_pixels(void *ctx, const uint16_t *pixels, size_t count) {
+    ili9341_host_t *host = host_state(ctx);
+
+    for (size_t i = 0; i < count; i++) {
+        host_data_byte(host, pixels[i] >> 8);
+        host_data_byte(host, pixels[i] & 0xFF);
+    }
+}
+
+static void host_fill_pixels(void *ctx, uint16_t color, size_t count) {
+    ili9341_host_t *host = host_state(ctx);
+
+    for (size_t i = 0; i < count; i++) {
+        host_data_byte(host, color >> 8);
+        host_data_byte(host, color & 0xFF);
+    }
+}
+
+// Asynchronous worker. The driver keeps at most one transfer in flight per
+// display, so a single job slot is enough.
+
+enum { JOB_PIXELS, JOB_FILL, JOB_BYTES };
+
+static void *host_worker(void *ctx) {
+    ili9341_host_t *host = host_state(ctx);
+
+    for (;;) {
+        pthread_mutex_lock(&host->worker_lock);
+        while (!host->job_pending) {
+            pthread_cond_wait(&host->worker_cond, &host->worker_lock);
+        }
+        const void *src = host->job_src;
+        uint8_t kind = host->job_kind;
+        size_t count = host->job_count;
+        void (*done)(void *arg) = host->job_done;
+        void *arg = host->job_arg;
+        pthread_mutex_unlock(&host->worker_lock);
+
+        if (host->async_delay_us) {
+            struct timespec delay = { 0, (long)host->async_delay_us * 1000 };
+            nanosleep(&delay, NULL);
+        }
+
+        switch (kind) {
+            case JOB_PIXELS: host_write_pixels(host, src, count); break;
+            case JOB_FILL: host_fill_pixels(host, *(const uint16_t *)src, count); break;
+            case JOB_BYTES: host_write_data(host, src, count); break;
+        }
+        host->async_transfers++;
+
+        pthread_mutex_lock(&host->worker_lock);
+        host->job_pending = false;
+        pthread_mutex_unlock(&host->worker_lock);
+
+        done(arg);
+    }
+    return NULL;
+}
+
+static void host_start(ili9341_host_t *host, const void *src, uint8_t kind, size_t count,
+                       void (*done)(void *arg), void *arg) {
+    pthread_mutex_lock(&host->worker_lock);
+    if (!host->worker_started) {
+        pthread_create(&host->worker, NULL, host_worker, host);
+        pthread_detach(host->worker);
+        host->worker_started = true;
+    }
+    host->job_src = src;
+    host->job_kind = kind;
+    host->job_count = count;
+    host->job_done = done;
+    host->job_arg = arg;
+    host->job_pending = true;
+    pthread_cond_signal(&host->worker_cond);
+    pthread_mutex_unlock(&host->worker_lock);
+}
+
+static void host_start_pixels(void *ctx, const uint16_t *pixels, size_t count,
+                              void (*done)(void *arg), void *arg) {
+    host_start(host_state(ctx), pixels, JOB_PIXELS, count, done, arg);
+}
+
+static void host_start_fill(void *ctx, const uint16_t *color, size_t count,
+                            void (*done)(void *arg), void *arg) {
+    host_start(host_state(ctx), color, JOB_FILL, count, done, arg);
+}
+
+static void host_start_bytes(void *ctx, const uint8_t *data, size_t len,
+                             void (*done)(void *arg), void *arg) {
+    host_start(host_state(ctx), data, JOB_BYTES, len, done, arg);
+}
+
+static uint32_t host_lock(void *ctx) {
+    pthread_mutex_lock(&host_state(ctx)->lock);
+    return 0;
+}
+
+static void host_unlock(void *ctx, uint32_t state) {
+    (void)state;
+    pthread_mutex_unlock(&host_state(ctx)->lock);
+}
+
+const ili9341_transport_t ili9341_host_transport = {
+    .init = host_init,
+    .reset = host_reset,
+    .delay_ms = host_delay_ms,
+    .begin = host_begin,
+    .end = host_end,
+    .write_command = host_write_command,
+    .write_data = host_write_data,
+    .write_pixels = host_write_pixels,
+    .fill_pixels = host_fill_pixels,
+    .start_pixels = host_start_pixels,
+    .start_fill = host_start_fill,
+    .start_bytes = host_start_bytes,
+    .lock = host_lock,
+    .unlock = host_unlock,
+};
+
+void ili9341_host_scanout(const ili9341_host_t *host, uint16_t *out) {
+    uint32_t top = host->scroll_top, area = host->scroll_area;
+    bool valid = area > 0 && top + area + host->scroll_bottom == ILI9341_HEIGHT &&
+                 host->scroll_start >= top && host->scroll_start < top + area;
+
+    for (uint32_t row = 0; row < ILI9341_HEIGHT; row++) {
+        // Rows of the scroll area show GRAM from scroll_start on, wrapping
+        // inside the area; an inconsistent definition shows GRAM as is
+        uint32_t source = row;
+        if (valid && row >= top && row < top + area) {
+            source = top + (row - top + host->scroll_start - top) % area;
+        }
+        memcpy(out + row * ILI9341_WIDTH, host->gram + source * ILI9341_WIDTH, ILI9341_WIDTH * sizeof(uint16_t));
+    }
+}
+
+void ili9341_host_reset_counters(ili9341_host_t *host) {
+    host->log_length = 0;
+    host->bytes = 0;
+    host->command_bytes = 0;
+    host->transactions = 0;
+    host->dc_toggles = 0;
+    host->delay_ms = 0;
+    host->caset = 0;
+    host->paset = 0;
+    host->ramwr = 0;
+    host->async_transfers = 0;
+}
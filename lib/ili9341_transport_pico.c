@@ -0,0 +1,216 @@
+#include "ili9341.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "hardware/sync.h"
+
+// Pico SPI transport. The context pointer is the ili9341_config_t that was
+// handed to ili9341_init().
+
+// Pixel streams shorter than this are byte-swapped into a small buffer;
+// longer ones switch the SPI to 16-bit frames so no per-pixel swap is needed.
+#define PIXEL_FRAME_THRESHOLD 16
+#define FILL_CHUNK            32
+
+static inline ili9341_config_t *pico_config(void *ctx) {
+    return (ili9341_config_t *)ctx;
+}
+
+// One DMA channel per SPI instance, claimed on first use. Completion is
+// reported from the shared DMA_IRQ_0 handler.
+typedef struct {
+    ili9341_config_t *config;
+    bool claimed;
+    uint channel;
+    void (*done)(void *arg);
+    void *arg;
+} pico_dma_t;
+
+static pico_dma_t g_dma[2];
+static bool g_dma_irq_installed = false;
+
+static void pico_init(void *ctx) {
+    ili9341_config_t *config = pico_config(ctx);
+
+    // Initialize SPI
+    spi_init(config->spi_port, config->baudrate);
+    gpio_set_function(config->mosi_pin, GPIO_FUNC_SPI);
+    gpio_set_function(config->sck_pin, GPIO_FUNC_SPI);
+
+    // Initialize control pins
+    gpio_init(config->cs_pin);
+    gpio_set_dir(config->cs_pin, GPIO_OUT);
+    gpio_put(config->cs_pin, 1);
+
+    gpio_init(config->dc_pin);
+    gpio_set_dir(config->dc_pin, GPIO_OUT);
+
+    gpio_init(config->rst_pin);
+    gpio_set_dir(config->rst_pin, GPIO_OUT);
+}
+
+static void pico_reset(void *ctx) {
+    ili9341_config_t *config = pico_config(ctx);
+
+    gpio_put(config->rst_pin, 1);
+    sleep_ms(5);
+    gpio_put(config->rst_pin, 0);
+    sleep_ms(20);
+    gpio_put(config->rst_pin, 1);
+    sleep_ms(150);
+}
+
+static void pico_delay_ms(void *ctx, uint32_t ms) {
+    (void)ctx;
+    sleep_ms(ms);
+}
+
+static void pico_begin(void *ctx) {
+    gpio_put(pico_config(ctx)->cs_pin, 0);
+}
+
+static void pico_end(void *ctx) {
+    gpio_put(pico_config(ctx)->cs_pin, 1);
+}
+
+// spi_write_blocking() returns only once the last bit has left the shifter,
+// so DC can be changed safely between calls.
+static void pico_write_command(void *ctx, uint8_t cmd) {
+    ili9341_config_t *config = pico_config(ctx);
+
+    gpio_put(config->dc_pin, 0);
+    spi_write_blocking(config->spi_port, &cmd, 1);
+    gpio_put(config->dc_pin, 1);
+}
+
+static void pico_write_data(void *ctx, const uint8_t *data, size_t len) {
+    spi_write_blocking(pico_config(ctx)->spi_port, data, len);
+}
+
+static void pico_write_pixels(void *ctx, const uint16_t *pixels, size_t count) {
+    ili9341_config_t *config = pico_config(ctx);
+
+    if (count < PIXEL_FRAME_THRESHOLD) {
+        uint8_t buffer[PIXEL_FRAME_THRESHOLD * 2];
+        for (size_t i = 0; i < count; i++) {
+            buffer[2 * i] = pixels[i] >> 8;
+            buffer[2 * i + 1] = pixels[i] & 0xFF;
+        }
+        spi_write_blocking(config->spi_port, buffer, count * 2);
+        return;
+    }
+
+    // 16-bit frames go out MSB first, which is the panel's byte order
+    spi_set_format(config->spi_port, 16, SPI_CPOL_0, SPI_CPHA_0, SPI_MSB_FIRST);
+    spi_write16_blocking(config->spi_port, pixels, count);
+    spi_set_format(config->spi_port, 8, SPI_CPOL_0, SPI_CPHA_0, SPI_MSB_FIRST);
+}
+
+static void pico_fill_pixels(void *ctx, uint16_t color, size_t count) {
+    ili9341_config_t *config = pico_config(ctx);
+    uint16_t buffer[FILL_CHUNK];
+
+    for (int i = 0; i < FILL_CHUNK; i++) {
+        buffer[i] = color;
+    }
+
+    spi_set_format(config->spi_port, 16, SPI_CPOL_0, SPI_CPHA_0, SPI_MSB_FIRST);
+    while (count > 0) {
+        size_t chunk = count < FILL_CHUNK ? count : FILL_CHUNK;
+        spi_write16_blocking(config->spi_port, buffer, chunk);
+        count -= chunk;
+    }
+    spi_set_format(config->spi_port, 8, SPI_CPOL_0, SPI_CPHA_0, SPI_MSB_FIRST);
+}
+
+static void pico_dma_irq(void) {
+    for (int i = 0; i < 2; i++) {
+        pico_dma_t *dma = &g_dma[i];
+        if (!dma->claimed || !dma->done || !dma_channel_get_irq0_status(dma->channel)) continue;
+        
+        dma_channel_acknowledge_irq0(dma->channel);
+        
+        // The DMA finishing only means the TX FIFO has been fed
+        spi_inst_t *spi = dma->config->spi_port;
+        while (spi_is_busy(spi)) tight_loop_contents();
+        while (spi_is_readable(spi)) (void)spi_get_hw(spi)->dr;
+        spi_get_hw(spi)->icr = SPI_SSPICR_RORIC_BITS;
+        spi_set_format(spi, 8, SPI_CPOL_0, SPI_CPHA_0, SPI_MSB_FIRST);
+        
+        void (*done)(void *arg) = dma->done;
+        dma->done = NULL;
+        done(dma->arg);
+    }
+}
+
+// Pixel transfers use 16-bit frames, which go out MSB first; byte
+// transfers stay in 8-bit mode
+static void pico_dma_start(void *ctx, const void *src, bool wide, bool increment, size_t count,
+                           void (*done)(void *arg), void *arg) {
+    ili9341_config_t *config = pico_config(ctx);
+    pico_dma_t *dma = &g_dma[spi_get_index(config->spi_port)];
+    
+    if (!dma->claimed) {
+        dma->channel = dma_claim_unused_channel(true);
+        dma->claimed = true;
+        dma_channel_set_irq0_enabled(dma->channel, true);
+        if (!g_dma_irq_installed) {
+            irq_add_shared_handler(DMA_IRQ_0, pico_dma_irq, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+            irq_set_enabled(DMA_IRQ_0, true);
+            g_dma_irq_installed = true;
+        }
+    }
+    dma->config = config;
+    dma->done = done;
+    dma->arg = arg;
+    
+    dma_channel_config c = dma_channel_get_default_config(dma->channel);
+    channel_config_set_transfer_data_size(&c, wide ? DMA_SIZE_16 : DMA_SIZE_8);
+    channel_config_set_read_increment(&c, increment);
+    channel_config_set_write_increment(&c, false);
+    channel_config_set_dreq(&c, spi_get_dreq(config->spi_port, true));
+    
+    if (wide) spi_set_format(config->spi_port, 16, SPI_CPOL_0, SPI_CPHA_0, SPI_MSB_FIRST);
+    dma_channel_configure(dma->channel, &c, &spi_get_hw(config->spi_port)->dr, src, count, true);
+}
+
+static void pico_start_pixels(void *ctx, const uint16_t *pixels, size_t count,
+                              void (*done)(void *arg), void *arg) {
+    pico_dma_start(ctx, pixels, true, true, count, done, arg);
+}
+
+static void pico_start_fill(void *ctx, const uint16_t *color, size_t count,
+                            void (*done)(void *arg), void *arg) {
+    pico_dma_start(ctx, color, true, false, count, done, arg);
+}
+
+static void pico_start_bytes(void *ctx, const uint8_t *data, size_t len,
+                             void (*done)(void *arg), void *arg) {
+    pico_dma_start(ctx, data, false, true, len, done, arg);
+}
+
+static uint32_t pico_lock(void *ctx) {
+    (void)ctx;
+    return save_and_disable_interrupts();
+}
+
+static void pico_unlock(void *ctx, uint32_t state) {
+    (void)ctx;
+    restore_interrupts(state);
+}
+
+const ili9341_transport_t ili9341_pico_transport = {
+    .init = pico_init,
+    .reset = pico_reset,
+    .delay_ms = pico_delay_ms,
+    .begin = pico_begin,
+    .end = pico_end,
+    .write_command = pico_write_command,
+    .write_data = pico_write_data,
+    .write_pixels = pico_write_pixels,
+    .fill_pixels = pico_fill_pixels,
+    .start_pixels = pico_start_pixels,
+    .start_fill = pico_start_fill,
+    .start_bytes = pico_start_bytes,
+    .lock = pico_lock,
+    .unlock = pico_unlock,
+};
@@ -0,0 +1,333 @@
+#include "ili9341_widget.h"
+#include <string.h>
+
+static void widget_init(ili9341_widget_t *w, void (*render)(ili9341_widget_t *, bool)) {
+    w->render = render;
+    w->next = NULL;
+    w->dirty = true;
+    w->invalid = true;
+}
+
+// UI
+
+void ili9341_ui_init(ili9341_ui_t *ui) {
+    ui->first = NULL;
+}
+
+void ili9341_ui_add(ili9341_ui_t *ui, ili9341_widget_t *widget) {
+    ili9341_widget_t **link = &ui->first;
+    while (*link) link = &(*link)->next;
+
+    widget->next = NULL;
+    widget->invalid = true;
+    *link = widget;
+}
+
+void ili9341_ui_invalidate(ili9341_ui_t *ui) {
+    for (ili9341_widget_t *w = ui->first; w; w = w->next) {
+        w->invalid = true;
+    }
+}
+
+void ili9341_ui_commit(ili9341_ui_t *ui) {
+    for (ili9341_widget_t *w = ui->first; w; w = w->next) {
+        if (!w->dirty && !w->invalid) continue;
+
+        w->render(w, w->invalid);
+        w->dirty = false;
+        w->invalid = false;
+    }
+}
+
+// Text cells
+
+#define TEXT_MAX (ILI9341_LABEL_MAX > ILI9341_READOUT_DIGITS ? ILI9341_LABEL_MAX : ILI9341_READOUT_DIGITS)
+
+// Redraw the first len cells of text that differ from shown (all of them
+// when full), one opaque string per run of changed cells, and record them
+// as shown. The gap column between cells is always background, so a run
+// can be redrawn without touching its neighbours.
+static void text_update(uint16_t x, uint16_t y, uint8_t size, uint16_t color, uint16_t bg,
+                        const char *text, char *shown, uint8_t len, bool full) {
+    char run[TEXT_MAX + 1];
+    uint32_t advance = 6 * size;
+    uint8_t i = 0;
+
+    while (i < len) {
+        if (!full && text[i] == shown[i]) {
+            i++;
+            continue;
+        }
+
+        uint8_t from = i;
+        while (i < len && (full || text[i] != shown[i])) {
+            run[i - from] = text[i];
+            shown[i] = text[i];
+            i++;
+        }
+        run[i - from] = '\0';
+        ili9341_draw_string(x + from * advance, y, run, color, bg, size);
+    }
+}
+
+// Label
+
+static void label_render(ili9341_widget_t *w, bool full) {
+    ili9341_label_t *label = (ili9341_label_t *)w;
+    uint32_t advance = 6 * label->size;
+    uint8_t len = strlen(label->text);
+
+    // Cells past the old text hold background, not characters
+    for (uint8_t i = label->shown_len; i < len; i++) label->shown[i] = '\0';
+
+    text_update(label->x, label->y, label->size, label->color, label->bg, label->text, label->shown,
+                len, full || label->color != label->shown_color);
+    label->shown_color = label->color;
+
+    // Clear what is left of longer text, from the new gap column on
+    if (label->shown_len > len) {
+        uint32_t from = len ? len * advance - label->size : 0;
+        uint32_t to = label->shown_len * advance - label->size;
+        ili9341_fill_rect(label->x + from, label->y, to - from, 8 * label->size, label->bg);
+    }
+    label->shown_len = len;
+}
+
+void ili9341_label_init(ili9341_label_t *label, uint16_t x, uint16_t y, uint8_t size,
+                        uint16_t color, uint16_t bg, const char *text) {
+    widget_init(&label->base, label_render);
+    label->x = x;
+    label->y = y;
+    label->size = size;
+    label->color = color;
+    label->bg = bg;
+    label->text[0] = '\0';
+    label->shown_len = 0;
+    label->shown_color = color;
+    ili9341_label_set_text(label, text ? text : "");
+}
+
+void ili9341_label_set_text(ili9341_label_t *label, const char *text) {
+    if (strncmp(label->text, text, ILI9341_LABEL_MAX) == 0) return;
+
+    strncpy(label->text, text, ILI9341_LABEL_MAX);
+    label->text[ILI9341_LABEL_MAX] = '\0';
+    label->base.dirty = true;
+}
+
+void ili9341_label_set_color(ili9341_label_t *label, uint16_t color) {
+    if (label->color == color) return;
+
+    label->color = color;
+    label->base.dirty = true;
+}
+
+// Numeric readout
+
+// Right-align value in digits cells; values that do not fit show as '#'
+static void readout_format(const ili9341_readout_t *readout, char *text) {
+    uint32_t magnitude = readout->value < 0 ? 0u - (uint32_t)readout->value : (uint32_t)readout->value;
+    int i = readout->digits;
+
+    text[i] = '\0';
+    do {
+        text[--i] = '0' + magnitude % 10;
+        magnitude /= 10;
+    } while (magnitude && i > 0);
+    if (readout->value < 0 && i > 0) text[--i] = '-';
+
+    if (magnitude || (readout->value < 0 && text[i] != '-')) {
+        memset(text, '#', readout->digits);
+        return;
+    }
+    while (i > 0) text[--i] = ' ';
+}
+
+static void readout_render(ili9341_widget_t *w, bool full) {
+    ili9341_readout_t *readout = (ili9341_readout_t *)w;
+    char text[ILI9341_READOUT_DIGITS + 1];
+
+    readout_format(readout, text);
+    text_update(readout->x, readout->y, readout->size, readout->color, readout->bg, text, readout->shown,
+                readout->digits, full || readout->color != readout->shown_color);
+    readout->shown_color = readout->color;
+}
+
+void ili9341_readout_init(ili9341_readout_t *readout, uint16_t x, uint16_t y, uint8_t size,
+                          uint8_t digits, uint16_t color, uint16_t bg) {
+    widget_init(&readout->base, readout_render);
+    readout->x = x;
+    readout->y = y;
+    readout->size = size;
+    readout->digits = (digits == 0) ? 1 : (digits < ILI9341_READOUT_DIGITS) ? digits : ILI9341_READOUT_DIGITS;
+    readout->color = color;
+    readout->bg = bg;
+    readout->value = 0;
+    readout->shown_color = color;
+}
+
+void ili9341_readout_set_value(ili9341_readout_t *readout, int32_t value) {
+    if (readout->value == value) return;
+
+    readout->value = value;
+    readout->base.dirty = true;
+}
+
+void ili9341_readout_set_color(ili9341_readout_t *readout, uint16_t color) {
+    if (readout->color == color) return;
+
+    readout->color = color;
+    readout->base.dirty = true;
+}
+
+// Bar
+
+static void bar_render(ili9341_widget_t *w, bool full) {
+    ili9341_bar_t *bar = (ili9341_bar_t *)w;
+    uint16_t len = bar->max ? (uint32_t)bar->value * bar->w / bar->max : 0;
+
+    if (full || bar->color != bar->shown_color) {
+        if (len > 0) ili9341_fill_rect(bar->x, bar->y, len, bar->h, bar->color);
+        if (len < bar->w) ili9341_fill_rect(bar->x + len, bar->y, bar->w - len, bar->h, bar->bg);
+    } else if (len > bar->shown_len) {
+        ili9341_fill_rect(bar->x + bar->shown_len, bar->y, len - bar->shown_len, bar->h, bar->color);
+    } else if (len < bar->shown_len) {
+        ili9341_fill_rect(bar->x + len, bar->y, bar->shown_len - len, bar->h, bar->bg);
+    }
+    bar->shown_len = len;
+    bar->shown_color = bar->color;
+}
+
+void ili9341_bar_init(ili9341_bar_t *bar, uint16_t x, uint16_t y, uint16_t w, uint16_t h,
+                      uint16_t max, uint16_t color, uint16_t bg) {
+    widget_init(&bar->base, bar_render);
+    bar->x = x;
+    bar->y = y;
+    bar->w = w;
+    bar->h = h;
+    bar->max = max;
+    bar->color = color;
+    bar->bg = bg;
+    bar->value = 0;
+    bar->shown_len = 0;
+    bar->shown_color = color;
+}
+
+void ili9341_bar_set_value(ili9341_bar_t *bar, uint16_t value) {
+    if (value > bar->max) value = bar->max;
+    if (bar->value == value) return;
+
+    bar->value = value;
+    bar->base.dirty = true;
+}
+
+void ili9341_bar_set_color(ili9341_bar_t *bar, uint16_t color) {
+    if (bar->color == color) return;
+
+    bar->color = color;
+    bar->base.dirty = true;
+}
+
+// Segmented arc
+
+static void arc_angles(const ili9341_arc_t *arc, int i, int32_t *start, int32_t *end) {
+    *start = arc->start + (int32_t)i * arc->sweep / arc->segments;
+    *end = arc->start + (int32_t)(i + 1) * arc->sweep / arc->segments - arc->gap;
+}
+
+static void arc_render(ili9341_widget_t *w, bool full) {
+    ili9341_arc_t *arc = (ili9341_arc_t *)w;
+
+    for (int i = 0; i < arc->segments; i++) {
+        uint16_t color = (i < arc->active) ? arc->active_color : arc->inactive_color;
+        if (!full && arc->shown[i] == color) continue;
+
+        if (arc->cached) {
+            ili9341_fill_spans(&arc->spans[arc->first[i]], arc->first[i + 1] - arc->first[i], color);
+        } else {
+            int32_t start, end;
+            arc_angles(arc, i, &start, &end);
+            ili9341_fill_sector(arc->cx, arc->cy, arc->r_outer, arc->r_inner, start, end, color);
+        }
+        arc->shown[i] = color;
+    }
+}
+
+void ili9341_arc_init(ili9341_arc_t *arc, uint16_t cx, uint16_t cy, uint16_t r_outer, uint16_t r_inner,
+                      int32_t start, int32_t sweep, int32_t gap, uint8_t segments,
+                      uint16_t active_color, uint16_t inactive_color,
+                      ili9341_span_t *spans, size_t max_spans) {
+    widget_init(&arc->base, arc_render);
+    arc->cx = cx;
+    arc->cy = cy;
+    arc->r_outer = r_outer;
+    arc->r_inner = r_inner;
+    arc->start = start;
+    arc->sweep = sweep;
+    arc->gap = gap;
+    arc->segments = segments < ILI9341_ARC_MAX_SEGMENTS ? segments : ILI9341_ARC_MAX_SEGMENTS;
+    arc->active = 0;
+    arc->active_color = active_color;
+    arc->inactive_color = inactive_color;
+    arc->spans = spans;
+    arc->max_spans = max_spans;
+
+    // Rasterize every segment once, if the geometry fits
+    size_t used = 0;
+    arc->cached = (spans != NULL);
+    for (int i = 0; arc->cached && i < arc->segments; i++) {
+        int32_t seg_start, seg_end;
+        arc_angles(arc, i, &seg_start, &seg_end);
+
+        arc->first[i] = used;
+        used += ili9341_sector_spans(cx, cy, r_outer, r_inner, seg_start, seg_end, &spans[used],
+                                     used < max_spans ? max_spans - used : 0);
+        if (used > max_spans || used > UINT16_MAX) arc->cached = false;
+    }
+    arc->first[arc->segments] = used;
+}
+
+void ili9341_arc_set_active(ili9341_arc_t *arc, uint8_t active) {
+    if (active > arc->segments) active = arc->segments;
+    if (arc->active == active) return;
+
+    arc->active = active;
+    arc->base.dirty = true;
+}
+
+void ili9341_arc_set_color(ili9341_arc_t *arc, uint16_t active_color) {
+    if (arc->active_color == active_color) return;
+
+    arc->active_color = active_color;
+    arc->base.dirty = true;
+}
+
+// Indicator
+
+static void indicator_render(ili9341_widget_t *w, bool full) {
+    ili9341_indicator_t *indicator = (ili9341_indicator_t *)w;
+    uint16_t color = indicator->on ? indicator->on_color : indicator->off_color;
+    (void)full;
+
+    ili9341_draw_string(indicator->x, indicator->y, indicator->text, color, indicator->bg, indicator->size);
+}
+
+void ili9341_indicator_init(ili9341_indicator_t *indicator, uint16_t x, uint16_t y, uint8_t size,
+                            const char *text, uint16_t on_color, uint16_t off_color, uint16_t bg) {
+    widget_init(&indicator->base, indicator_render);
+    indicator->x = x;
+    indicator->y = y;
+    indicator->size = size;
+    indicator->text = text;
+    indicator->on_color = on_color;
+    indicator->off_color = off_color;
+    indicator->bg = bg;
+    indicator->on = false;
+}
+
+void ili9341_indicator_set(ili9341_indicator_t *indicator, bool on) {
+    if (indicator->on == on) return;
+
+    indicator->on = on;
+    indicator->base.dirty = true;
+}
@@ -0,0 +1,146 @@
+#ifndef ILI9341_WIDGET_H
+#define ILI9341_WIDGET_H
+
+#include "ili9341.h"
+
+// Retained-mode widgets
+//
+// Each widget keeps its inputs and what it last put on screen. Setters only
+// record new inputs and mark the widget dirty when they differ; nothing is
+// drawn until ili9341_ui_commit(), which redraws just the dirty widgets and
+// only the parts of them that changed: a bar fills the strip between its
+// old and new length, a segmented arc repaints the segments whose color
+// changed, labels and readouts redraw only the character cells that
+// differ, opaque, with no separate clear.
+//
+// Widgets are plain structs owned by the caller. Initialize one, add it to
+// a ui, then set its inputs and commit once per frame. After repainting
+// the screen behind the widgets, call ili9341_ui_invalidate() so the next
+// commit draws them in full.
+
+// Longest label text, in characters
+#ifndef ILI9341_LABEL_MAX
+#define ILI9341_LABEL_MAX 24
+#endif
+
+// Most character cells in a numeric readout
+#ifndef ILI9341_READOUT_DIGITS
+#define ILI9341_READOUT_DIGITS 11
+#endif
+
+// Most segments in a segmented arc
+#ifndef ILI9341_ARC_MAX_SEGMENTS
+#define ILI9341_ARC_MAX_SEGMENTS 48
+#endif
+
+typedef struct ili9341_widget {
+    void (*render)(struct ili9341_widget *w, bool full);
+    struct ili9341_widget *next;
+    bool dirty;             // Inputs differ from what is on screen
+    bool invalid;           // Screen contents lost, draw in full
+} ili9341_widget_t;
+
+typedef struct {
+    ili9341_widget_t *first;
+} ili9341_ui_t;
+
+void ili9341_ui_init(ili9341_ui_t *ui);
+void ili9341_ui_add(ili9341_ui_t *ui, ili9341_widget_t *widget);    // Drawn in the order added
+void ili9341_ui_invalidate(ili9341_ui_t *ui);
+void ili9341_ui_commit(ili9341_ui_t *ui);
+
+// Label: a line of text. Text that gets shorter has its old tail cleared.
+// Labels and readouts draw opaque text: bg must differ from color.
+typedef struct {
+    ili9341_widget_t base;
+    uint16_t x, y;
+    uint8_t size;
+    uint16_t color, bg;
+    char text[ILI9341_LABEL_MAX + 1];
+    char shown[ILI9341_LABEL_MAX];      // Characters on screen
+    uint8_t shown_len;
+    uint16_t shown_color;
+} ili9341_label_t;
+
+void ili9341_label_init(ili9341_label_t *label, uint16_t x, uint16_t y, uint8_t size,
+                        uint16_t color, uint16_t bg, const char *text);
+void ili9341_label_set_text(ili9341_label_t *label, const char *text);
+void ili9341_label_set_color(ili9341_label_t *label, uint16_t color);
+
+// Numeric readout: an integer right-aligned in a fixed number of
+// character cells, so every value covers the same area. Values too wide
+// for the cells show as '#'. Going from 118 to 121 redraws two cells.
+typedef struct {
+    ili9341_widget_t base;
+    uint16_t x, y;
+    uint8_t size;
+    uint8_t digits;         // Cells, sign included
+    uint16_t color, bg;
+    int32_t value;
+    char shown[ILI9341_READOUT_DIGITS];     // Characters on screen
+    uint16_t shown_color;
+} ili9341_readout_t;
+
+void ili9341_readout_init(ili9341_readout_t *readout, uint16_t x, uint16_t y, uint8_t size,
+                          uint8_t digits, uint16_t color, uint16_t bg);
+void ili9341_readout_set_value(ili9341_readout_t *readout, int32_t value);
+void ili9341_readout_set_color(ili9341_readout_t *readout, uint16_t color);
+
+// Bar: filled from the left in proportion to value / max
+typedef struct {
+    ili9341_widget_t base;
+    uint16_t x, y, w, h;
+    uint16_t color, bg;
+    uint16_t max, value;
+    uint16_t shown_len;     // Filled columns on screen
+    uint16_t shown_color;
+} ili9341_bar_t;
+
+void ili9341_bar_init(ili9341_bar_t *bar, uint16_t x, uint16_t y, uint16_t w, uint16_t h,
+                      uint16_t max, uint16_t color, uint16_t bg);
+void ili9341_bar_set_value(ili9341_bar_t *bar, uint16_t value);
+void ili9341_bar_set_color(ili9341_bar_t *bar, uint16_t color);
+
+// Segmented arc: segments annular sectors spread clockwise over sweep from
+// start (ili9341_math.h angle units), separated by gap. The first active
+// segments are drawn in the active color, the rest in the inactive one.
+// With a span buffer the segment geometry is rasterized once and repaints
+// are filled from it (about 10 spans per segment for a 12-pixel ring of
+// 40 segments); without one, or if it is too small, sectors are
+// rasterized on every repaint.
+typedef struct {
+    ili9341_widget_t base;
+    uint16_t cx, cy, r_outer, r_inner;
+    int32_t start, sweep, gap;
+    uint8_t segments, active;
+    uint16_t active_color, inactive_color;
+
+    ili9341_span_t *spans;
+    size_t max_spans;
+    bool cached;
+    uint16_t first[ILI9341_ARC_MAX_SEGMENTS + 1];   // Segment i is spans first[i]..first[i + 1] - 1
+    uint16_t shown[ILI9341_ARC_MAX_SEGMENTS];       // Segment colors on screen
+} ili9341_arc_t;
+
+void ili9341_arc_init(ili9341_arc_t *arc, uint16_t cx, uint16_t cy, uint16_t r_outer, uint16_t r_inner,
+                      int32_t start, int32_t sweep, int32_t gap, uint8_t segments,
+                      uint16_t active_color, uint16_t inactive_color,
+                      ili9341_span_t *spans, size_t max_spans);
+void ili9341_arc_set_active(ili9341_arc_t *arc, uint8_t active);
+void ili9341_arc_set_color(ili9341_arc_t *arc, uint16_t active_color);
+
+// Indicator: a text symbol lit in on_color or dimmed to off_color
+typedef struct {
+    ili9341_widget_t base;
+    uint16_t x, y;
+    uint8_t size;
+    const char *text;
+    uint16_t on_color, off_color, bg;
+    bool on;
+} ili9341_indicator_t;
+
+void ili9341_indicator_init(ili9341_indicator_t *indicator, uint16_t x, uint16_t y, uint8_t size,
+                            const char *text, uint16_t on_color, uint16_t off_color, uint16_t bg);
+void ili9341_indicator_set(ili9341_indicator_t *indicator, bool on);
+
+#endif // ILI9341_WIDGET_H
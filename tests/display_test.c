@@ -0,0 +1,191 @@
+// Two displays drawn from two threads, on the host transport
+//
+// Each thread draws random primitives on its own display through the _on
+// calls, with clipping, rotation, scrolling and recorded ops replayed,
+// while the other thread does the same on the other display, and a third
+// display stays selected. The result must match drawing both sequences
+// one after the other on one thread: same bus traffic, same GRAM. Adding
+// -fsanitize=thread checks that the two threads share no driver state.
+// Exits with status 1 on the first difference.
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ili9341.h"
+#include "ili9341_host.h"
+#include "ili9341_math.h"
+
+#ifndef SEEDS
+#define SEEDS 10
+#endif
+#define PRIMITIVES 2000
+#define RECORDED 16                 // Ops captured and replayed per batch
+
+typedef struct {
+    ili9341_host_t host;
+    ili9341_config_t config;
+    ili9341_display_t display;
+    uint16_t gram[ILI9341_WIDTH * ILI9341_HEIGHT];
+    uint32_t seed;
+    ili9341_op_t ops[RECORDED];
+    size_t op_count;
+} panel_t;
+
+static panel_t panels[2];
+static panel_t idle;                // Selected while the threads draw
+
+// Without DMA hooks the async calls run synchronously on the calling thread
+static ili9341_transport_t transport;
+
+static uint16_t bitmap[48 * 32];
+static uint8_t bitmap_be[48 * 32 * 2];
+static const uint8_t mask[] = { 0x6C, 0xFE, 0xFE, 0x7C, 0x38, 0x10, 0x00 };
+static const uint8_t indexed[] = { 0x1B, 0xE4, 0x1B, 0xE4, 0x6C, 0x93, 0x39, 0xC6 };
+static const uint16_t palette[] = { BLACK, RED, GREEN, BLUE };
+static ili9341_span_t spans[128];
+static size_t span_count;
+
+static uint32_t next_random(panel_t *p) {
+    p->seed = p->seed * 1103515245u + 12345u;
+    return p->seed >> 8;
+}
+
+static int32_t random_range(panel_t *p, int32_t lo, int32_t hi) {
+    return lo + (int32_t)(next_random(p) % (uint32_t)(hi - lo + 1));
+}
+
+static void record(void *ctx, const ili9341_op_t *op) {
+    panel_t *p = ctx;
+    if (p->op_count < RECORDED) p->ops[p->op_count++] = *op;
+}
+
+static void draw_random(panel_t *p, ili9341_display_t *d) {
+    int16_t x = random_range(p, -40, 340), y = random_range(p, -40, 260);
+    uint16_t color = next_random(p);
+
+    switch (next_random(p) % 20) {
+        case 0: ili9341_fill_rect_on(d, x, y, random_range(p, 0, 150), random_range(p, 0, 100), color); break;
+        case 1: ili9341_draw_line_on(d, x, y, random_range(p, -40, 340), random_range(p, -40, 260), color); break;
+        case 2: ili9341_draw_rect_on(d, x, y, random_range(p, 0, 120), random_range(p, 0, 90), color); break;
+        case 3: ili9341_draw_circle_on(d, x, y, random_range(p, 0, 80), color); break;
+        case 4: ili9341_fill_circle_on(d, x, y, random_range(p, 0, 60), color); break;
+        case 5: ili9341_fill_ellipse_on(d, x, y, random_range(p, 0, 60), random_range(p, 0, 40), color); break;
+        case 6: ili9341_fill_ring_on(d, x, y, random_range(p, 20, 70), random_range(p, 0, 19), color); break;
+        case 7:
+            ili9341_fill_sector_on(d, x, y, random_range(p, 20, 90), random_range(p, 0, 19),
+                                   random_range(p, 0, ILI9341_ANGLE_TURN),
+                                   random_range(p, 0, 2 * ILI9341_ANGLE_TURN), color);
+            break;
+        case 8: ili9341_fill_spans_on(d, spans, span_count, color); break;
+        case 9: ili9341_draw_string_on(d, x, y, "Two cores", color, next_random(p), random_range(p, 1, 3)); break;
+        case 10: ili9341_draw_char_on(d, x, y, 'Q', color, color, random_range(p, 1, 4)); break;
+        case 11: ili9341_draw_bitmap_on(d, x, y, 48, 32, bitmap); break;
+        case 12: ili9341_draw_bitmap_be_on(d, x, y, 48, 32, bitmap_be); break;
+        case 13: ili9341_draw_bitmap_mask_on(d, x, y, 7, 7, mask, color, next_random(p), random_range(p, 1, 4)); break;
+        case 14: ili9341_draw_bitmap_indexed_on(d, x, y, 8, 4, 2, indexed, palette); break;
+        case 15: ili9341_fill_rect_async_on(d, x, y, random_range(p, 1, 100), random_range(p, 1, 100), color, NULL, NULL); break;
+        case 16: ili9341_draw_pixel_on(d, x, y, color); break;
+        case 17:
+            ili9341_clip_reset_on(d);
+            ili9341_clip_push_on(d, x, y, random_range(p, 40, 300), random_range(p, 40, 200));
+            break;
+        case 18: ili9341_scroll_on(d, random_range(p, -20, 20)); break;
+        default:
+            // Record a few calls under their clip, then replay them
+            p->op_count = 0;
+            ili9341_set_capture_on(d, record, p);
+            ili9341_fill_circle_on(d, x, y, random_range(p, 0, 40), color);
+            ili9341_draw_string_on(d, x, y + 40, "rec", color, ~color, 2);
+            ili9341_set_capture_on(d, NULL, NULL);
+            for (size_t i = 0; i < p->op_count; i++) ili9341_op_draw_on(d, &p->ops[i]);
+            break;
+    }
+}
+
+static void draw_all(panel_t *p, ili9341_display_t *d, uint32_t seed) {
+    p->seed = seed;
+    ili9341_set_rotation_on(d, seed % 4);
+    ili9341_scroll_define_on(d, seed % 32, seed % 17);
+    for (int i = 0; i < PRIMITIVES; i++) draw_random(p, d);
+    ili9341_clip_reset_on(d);
+}
+
+static void *draw_thread(void *arg) {
+    panel_t *p = arg;
+    draw_all(p, &p->display, p->seed);
+    return NULL;
+}
+
+static void reset(void) {
+    for (int i = 0; i < 2; i++) {
+        memset(panels[i].gram, 0, sizeof(panels[i].gram));
+        ili9341_host_reset_counters(&panels[i].host);
+    }
+}
+
+int main(void) {
+    for (size_t i = 0; i < sizeof(bitmap) / sizeof(bitmap[0]); i++) {
+        bitmap[i] = (uint16_t)(i * 2654435761u >> 16);
+        bitmap_be[2 * i] = (uint8_t)(i * 7);
+        bitmap_be[2 * i + 1] = (uint8_t)(i * 13);
+    }
+    span_count = ili9341_sector_spans(160, 120, 90, 50, ILI9341_DEG(30), ILI9341_DEG(150),
+                                      spans, sizeof(spans) / sizeof(spans[0]));
+    if (span_count > sizeof(spans) / sizeof(spans[0])) span_count = sizeof(spans) / sizeof(spans[0]);
+
+    transport = ili9341_host_transport;
+    transport.start_pixels = NULL;
+    transport.start_bytes = NULL;
+    transport.start_fill = NULL;
+    for (int i = 0; i < 3; i++) {
+        panel_t *p = (i < 2) ? &panels[i] : &idle;
+        p->host.gram = p->gram;
+        p->config.transport = &transport;
+        p->config.transport_ctx = &p->host;
+        ili9341_display_init(&p->display, &p->config);
+    }
+
+    static uint16_t expected[2][ILI9341_WIDTH * ILI9341_HEIGHT];
+    uint64_t bytes[2], transactions[2];
+
+    for (uint32_t seed = 1; seed <= SEEDS; seed++) {
+        uint32_t seeds[2] = { seed * 7919u, seed * 104729u + 1 };
+
+        // One after the other
+        reset();
+        for (int i = 0; i < 2; i++) {
+            draw_all(&panels[i], &panels[i].display, seeds[i]);
+            memcpy(expected[i], panels[i].gram, sizeof(expected[i]));
+            bytes[i] = panels[i].host.bytes;
+            transactions[i] = panels[i].host.transactions;
+        }
+
+        // Both at once
+        reset();
+        ili9341_display_select(&idle.display);
+        pthread_t threads[2];
+        for (int i = 0; i < 2; i++) {
+            panels[i].seed = seeds[i];
+            pthread_create(&threads[i], NULL, draw_thread, &panels[i]);
+        }
+        for (int i = 0; i < 2; i++) pthread_join(threads[i], NULL);
+
+        for (int i = 0; i < 2; i++) {
+            const ili9341_host_t *h = &panels[i].host;
+            if (h->bytes != bytes[i] || h->transactions != transactions[i]) {
+                printf("FAIL seed %lu display %d: %llu bytes, %llu transactions; want %llu, %llu\n",
+                       (unsigned long)seed, i, (unsigned long long)h->bytes,
+                       (unsigned long long)h->transactions, (unsigned long long)bytes[i],
+                       (unsigned long long)transactions[i]);
+                return 1;
+            }
+            if (memcmp(panels[i].gram, expected[i], sizeof(expected[i])) != 0) {
+                printf("FAIL seed %lu display %d: GRAM differs\n", (unsigned long)seed, i);
+                return 1;
+            }
+        }
+    }
+    printf("%d seeds, %d primitives per display: ok\n", SEEDS, PRIMITIVES);
+    return 0;
+}
@@ -0,0 +1,122 @@
+// Hardware scrolling in every rotation, on the host transport
+//
+// The scroll ring is fixed to the panel: its rows are the rows of
+// ILI9341_ROTATION_0. In 180 they run bottom to top, and in 90 and 270 the
+// ring moves along x, row r being column r (90) or ILI9341_HEIGHT - 1 - r
+// (270). For each rotation this fills every screen row through
+// ili9341_scroll_y() at several scroll offsets, scrolls like a console
+// adding lines at the bottom, and checks what ili9341_host_scanout()
+// shows. Exits with status 1 on the first mismatch.
+
+#include <stdio.h>
+#include <string.h>
+#include "ili9341.h"
+#include "ili9341_host.h"
+
+#define TOP_FIXED 16
+#define BOTTOM_FIXED 24
+#define AREA (ILI9341_HEIGHT - TOP_FIXED - BOTTOM_FIXED)
+
+static uint16_t gram[ILI9341_WIDTH * ILI9341_HEIGHT];
+static uint16_t screen[ILI9341_WIDTH * ILI9341_HEIGHT];
+static ili9341_host_t host = { .gram = gram };
+
+// Expected color of each panel row on screen
+static uint16_t expected[ILI9341_HEIGHT];
+
+static uint16_t row_color(uint32_t n) {
+    return (uint16_t)(n * 40503u + 1);
+}
+
+// Fill the whole GRAM row that holds panel row r, in the current rotation
+static void fill_panel_row(uint16_t r, uint16_t color) {
+    switch (ili9341_get_rotation()) {
+        case ILI9341_ROTATION_0:
+            ili9341_fill_rect(0, r, ili9341_width(), 1, color);
+            break;
+        case ILI9341_ROTATION_90:
+            ili9341_fill_rect(r, 0, 1, ili9341_height(), color);
+            break;
+        case ILI9341_ROTATION_180:
+            ili9341_fill_rect(0, ILI9341_HEIGHT - 1 - r, ili9341_width(), 1, color);
+            break;
+        default:
+            ili9341_fill_rect(ILI9341_HEIGHT - 1 - r, 0, 1, ili9341_height(), color);
+            break;
+    }
+}
+
+static bool check(const char *what, uint8_t rotation, uint16_t offset) {
+    ili9341_host_scanout(&host, screen);
+    for (uint32_t row = 0; row < ILI9341_HEIGHT; row++) {
+        for (uint32_t x = 0; x < ILI9341_WIDTH; x++) {
+            uint16_t got = screen[row * ILI9341_WIDTH + x];
+            if (got != expected[row]) {
+                printf("FAIL %s: rotation %u, offset %u, row %lu, x %lu: %04X, want %04X\n", what,
+                       rotation * 90, offset, (unsigned long)row, (unsigned long)x, got, expected[row]);
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+static bool test_rotation(uint8_t rotation) {
+    static const uint16_t offsets[] = { 0, 1, 57, AREA - 1, AREA + 3 };
+
+    ili9341_set_rotation(rotation);
+    ili9341_scroll_define(TOP_FIXED, BOTTOM_FIXED);
+
+    // Every screen row drawn through ili9341_scroll_y() lands where asked
+    for (size_t i = 0; i < sizeof(offsets) / sizeof(offsets[0]); i++) {
+        ili9341_scroll_set(offsets[i]);
+        for (uint16_t r = 0; r < ILI9341_HEIGHT; r++) {
+            expected[r] = row_color(r + i * ILI9341_HEIGHT);
+            fill_panel_row(ili9341_scroll_y(r), expected[r]);
+        }
+        if (!check("scroll_y", rotation, ili9341_scroll_offset())) return false;
+    }
+
+    // Console: move the content up a line and fill the bottom one; the
+    // fixed areas stay put
+    uint16_t bottom = TOP_FIXED + AREA - 1;
+    for (uint32_t line = 0; line < 2 * AREA + 5; line++) {
+        ili9341_scroll(1);
+        memmove(&expected[TOP_FIXED], &expected[TOP_FIXED + 1], (AREA - 1) * sizeof(expected[0]));
+        expected[bottom] = row_color(100000 + line);
+        fill_panel_row(ili9341_scroll_y(bottom), expected[bottom]);
+        if (!check("scroll up", rotation, ili9341_scroll_offset())) return false;
+    }
+
+    // And back down, exposing the top line of the area
+    for (uint32_t line = 0; line < AREA + 5; line++) {
+        ili9341_scroll(-1);
+        memmove(&expected[TOP_FIXED + 1], &expected[TOP_FIXED], (AREA - 1) * sizeof(expected[0]));
+        expected[TOP_FIXED] = row_color(200000 + line);
+        fill_panel_row(ili9341_scroll_y(TOP_FIXED), expected[TOP_FIXED]);
+        if (!check("scroll down", rotation, ili9341_scroll_offset())) return false;
+    }
+
+    // Redefining the area resets the offset
+    ili9341_scroll_define(0, 0);
+    if (ili9341_scroll_offset() != 0) {
+        printf("FAIL scroll_define: rotation %u, offset %u after redefining\n", rotation * 90,
+               ili9341_scroll_offset());
+        return false;
+    }
+    return true;
+}
+
+int main(void) {
+    ili9341_config_t config = {
+        .transport = &ili9341_host_transport,
+        .transport_ctx = &host,
+    };
+    ili9341_init(&config);
+
+    for (uint8_t rotation = 0; rotation < 4; rotation++) {
+        if (!test_rotation(rotation)) return 1;
+        printf("rotation %3u: ok\n", rotation * 90);
+    }
+    return 0;
+}
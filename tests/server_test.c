@@ -0,0 +1,187 @@
+// Display server ordering and back-pressure, on the host transport
+//
+// Draws the same random primitives twice, once on a display driving a host
+// transport directly and once through ili9341_server_transport in front of
+// a second host transport, and requires both to see the same bus events
+// and end with the same GRAM. Build it with a small ring so every batch
+// wraps it and the producer has to wait:
+//
+//     -DILI9341_SERVER_RING=256
+//
+// Exits with status 1 on the first difference, or if the producer never
+// waited on a full ring.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ili9341.h"
+#include "ili9341_host.h"
+#include "ili9341_math.h"
+#include "ili9341_server.h"
+
+#ifndef SEEDS
+#define SEEDS 20
+#endif
+#define BATCHES 6
+#define PRIMITIVES 500              // Per batch, compared after each
+#define LOG_CAPACITY (4u << 20)     // Events per batch
+
+typedef struct {
+    ili9341_host_t host;
+    ili9341_config_t config;
+    ili9341_display_t display;
+} panel_t;
+
+static uint16_t gram_direct[ILI9341_WIDTH * ILI9341_HEIGHT];
+static uint16_t gram_served[ILI9341_WIDTH * ILI9341_HEIGHT];
+static panel_t direct, served;
+static ili9341_server_t server;
+
+// The server transport has no DMA hooks, so the direct display goes
+// without them too: both run the async calls synchronously, and the server
+// thread is the only one running beside the test
+static ili9341_transport_t direct_transport;
+
+static uint16_t bitmap[64 * 48];
+static uint8_t bitmap_be[64 * 48 * 2];
+static ili9341_span_t spans[256];
+static size_t span_count;
+
+static uint32_t g_seed;
+
+static uint32_t next_random(void) {
+    g_seed = g_seed * 1103515245u + 12345u;
+    return g_seed >> 8;
+}
+
+static int32_t random_range(int32_t lo, int32_t hi) {
+    return lo + (int32_t)(next_random() % (uint32_t)(hi - lo + 1));
+}
+
+static void draw_random(void) {
+    int16_t x = random_range(-40, 340), y = random_range(-40, 260);
+    uint16_t color = next_random();
+    uint8_t params[4];
+
+    switch (next_random() % 16) {
+        case 0: ili9341_fill_rect(x, y, random_range(0, 200), random_range(0, 150), color); break;
+        case 1: ili9341_draw_line(x, y, random_range(-40, 340), random_range(-40, 260), color); break;
+        case 2: ili9341_draw_rect(x, y, random_range(0, 120), random_range(0, 90), color); break;
+        case 3: ili9341_draw_circle(x, y, random_range(0, 80), color); break;
+        case 4: ili9341_fill_circle(x, y, random_range(0, 60), color); break;
+        case 5: ili9341_fill_ring(x, y, random_range(20, 70), random_range(0, 19), color); break;
+        case 6:
+            ili9341_fill_sector(x, y, random_range(20, 90), random_range(0, 19),
+                                random_range(0, ILI9341_ANGLE_TURN), random_range(0, 2 * ILI9341_ANGLE_TURN), color);
+            break;
+        case 7: ili9341_fill_spans(spans, span_count, color); break;
+        case 8: ili9341_draw_string(x, y, "Server ring", color, next_random(), random_range(1, 3)); break;
+        case 9: ili9341_draw_string(x, y, "wrap", color, color, random_range(1, 4)); break;
+        case 10: ili9341_draw_bitmap(x, y, 64, 48, bitmap); break;
+        case 11: ili9341_draw_bitmap_be(x, y, 64, 48, bitmap_be); break;
+        case 12: ili9341_fill_rect_async(x, y, random_range(1, 100), random_range(1, 100), color, NULL, NULL); break;
+        case 13: ili9341_draw_bitmap_async(x, y, 64, 48, bitmap, NULL, NULL); break;
+        case 14: ili9341_scroll(random_range(-20, 20)); break;
+        default:
+            // Raw commands and data between primitives
+            params[0] = 0;
+            params[1] = random_range(0, 100);
+            params[2] = 0;
+            params[3] = random_range(101, 239);
+            ili9341_write_command_data(ILI9341_PASET, params, sizeof(params));
+            ili9341_write_command(ILI9341_RAMWR);
+            ili9341_write_data16(color);
+            ili9341_set_window(x, y, x + 10, y + 10);
+            break;
+    }
+}
+
+static void draw_batch(panel_t *panel, uint32_t seed) {
+    ili9341_display_select(&panel->display);
+    g_seed = seed;
+    ili9341_set_rotation(seed % 4);
+    ili9341_scroll_define(seed % 32, seed % 17);
+    for (int i = 0; i < PRIMITIVES; i++) draw_random();
+    ili9341_async_wait();
+}
+
+static void panel_init(panel_t *panel, uint16_t *gram, const ili9341_transport_t *transport, void *ctx) {
+    panel->host.gram = gram;
+    panel->host.log = calloc(LOG_CAPACITY, sizeof(ili9341_host_event_t));
+    panel->host.log_capacity = LOG_CAPACITY;
+    panel->config.transport = transport;
+    panel->config.transport_ctx = ctx;
+    ili9341_display_init(&panel->display, &panel->config);
+}
+
+static bool compare(uint32_t seed, int batch) {
+    const ili9341_host_t *a = &direct.host, *b = &served.host;
+
+    if (a->log_length == a->log_capacity || b->log_length == b->log_capacity) {
+        printf("FAIL seed %lu batch %d: event log full\n", (unsigned long)seed, batch);
+        return false;
+    }
+    if (a->log_length != b->log_length || a->bytes != b->bytes || a->transactions != b->transactions) {
+        printf("FAIL seed %lu batch %d: %lu events, %llu bytes, %llu transactions direct; "
+               "%lu, %llu, %llu served\n", (unsigned long)seed, batch,
+               (unsigned long)a->log_length, (unsigned long long)a->bytes, (unsigned long long)a->transactions,
+               (unsigned long)b->log_length, (unsigned long long)b->bytes, (unsigned long long)b->transactions);
+        return false;
+    }
+    for (size_t i = 0; i < a->log_length; i++) {
+        if (a->log[i].type != b->log[i].type || a->log[i].value != b->log[i].value) {
+            printf("FAIL seed %lu batch %d: event %lu is %u/%02X direct, %u/%02X served\n",
+                   (unsigned long)seed, batch, (unsigned long)i, a->log[i].type, a->log[i].value,
+                   b->log[i].type, b->log[i].value);
+            return false;
+        }
+    }
+    if (memcmp(gram_direct, gram_served, sizeof(gram_direct)) != 0) {
+        printf("FAIL seed %lu batch %d: GRAM differs\n", (unsigned long)seed, batch);
+        return false;
+    }
+    return true;
+}
+
+int main(void) {
+    for (size_t i = 0; i < sizeof(bitmap) / sizeof(bitmap[0]); i++) {
+        bitmap[i] = (uint16_t)(i * 2654435761u >> 16);
+        bitmap_be[2 * i] = (uint8_t)(i * 7);
+        bitmap_be[2 * i + 1] = (uint8_t)(i * 13);
+    }
+    span_count = ili9341_sector_spans(160, 120, 100, 60, ILI9341_DEG(200), ILI9341_DEG(340),
+                                      spans, sizeof(spans) / sizeof(spans[0]));
+    if (span_count > sizeof(spans) / sizeof(spans[0])) span_count = sizeof(spans) / sizeof(spans[0]);
+
+    direct_transport = ili9341_host_transport;
+    direct_transport.start_pixels = NULL;
+    direct_transport.start_bytes = NULL;
+    direct_transport.start_fill = NULL;
+    panel_init(&direct, gram_direct, &direct_transport, &direct.host);
+    ili9341_server_init(&server, &ili9341_host_transport, &served.host);
+    panel_init(&served, gram_served, &ili9341_server_transport, &server);
+    ili9341_server_sync(&server);
+
+    unsigned long primitives = 0;
+    for (uint32_t seed = 1; seed <= SEEDS; seed++) {
+        for (int batch = 0; batch < BATCHES; batch++) {
+            uint32_t batch_seed = seed * 7919u + batch;
+
+            ili9341_host_reset_counters(&direct.host);
+            ili9341_host_reset_counters(&served.host);
+            draw_batch(&direct, batch_seed);
+            draw_batch(&served, batch_seed);
+            ili9341_server_sync(&server);
+            if (!compare(seed, batch)) return 1;
+            primitives += PRIMITIVES;
+        }
+    }
+
+    printf("%lu primitives, ring %u bytes: %lu stalls, high water %lu\n", primitives,
+           (unsigned)ILI9341_SERVER_RING, (unsigned long)server.stalls, (unsigned long)server.high_water);
+    if (server.stalls == 0) {
+        printf("FAIL the ring never filled; build with a smaller ILI9341_SERVER_RING\n");
+        return 1;
+    }
+    return 0;
+}
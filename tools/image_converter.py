@@ -15,7 +15,189 @@ def rgb888_to_rgb565(r, g, b):
     b5 = (b >> 3) & 0x1F  # 5 bits for blue
     return (r5 << 11) | (g6 << 5) | b5
 
-def convert_image(input_file, output_file, var_name, max_width=None, max_height=None):
+# Output formats and their C element type
+#   rgb565        uint16_t RGB565 values, for ili9341_draw_bitmap()
+#   native        uint16_t with the two bytes swapped, so the array is panel
+#                 byte order in a little-endian MCU's memory
+#   native-bytes  uint8_t big-endian pairs
+#   compressed    uint8_t stream plus an ili9341_image_t descriptor, for
+#                 ili9341_draw_image() (lib/ili9341_image.h)
+#   indexed       uint8_t packed palette indices at 1, 2, 4 or 8 bpp plus a
+#                 uint16_t palette, for ili9341_draw_bitmap_indexed()
+# Both native formats are drawn with ili9341_draw_bitmap_be().
+FORMATS = {
+    'rgb565': 'uint16_t',
+    'native': 'uint16_t',
+    'native-bytes': 'uint8_t',
+    'compressed': 'uint8_t',
+    'indexed': 'uint8_t',
+}
+
+INDEXED_BPP = (1, 2, 4, 8)
+
+def quantize(img, colors):
+    """
+    Reduce an RGB image to at most the given number of colors. Art that
+    already fits keeps its exact colors; anything else is median-cut
+    quantized by PIL.
+    """
+    if img.getcolors(colors) is None:
+        img = img.quantize(colors).convert('RGB')
+    return img
+
+def palettize(rgb565, bpp=None):
+    """
+    Split RGB565 pixels into (palette, indices, bpp). The smallest depth
+    that holds every color is used unless bpp is given.
+    """
+    palette = sorted(set(rgb565))
+    if bpp is None:
+        bpp = next((b for b in INDEXED_BPP if len(palette) <= 1 << b), 8)
+    if len(palette) > 1 << bpp:
+        raise ValueError(f"{len(palette)} colors do not fit in {bpp} bpp")
+    lookup = {color: i for i, color in enumerate(palette)}
+    return palette, [lookup[p] for p in rgb565], bpp
+
+def pack_indices(indices, width, bpp):
+    """Pack indices most significant bits first, each row from a byte boundary"""
+    out = bytearray()
+    for row in range(0, len(indices), width):
+        byte, used = 0, 0
+        for index in indices[row:row + width]:
+            byte = (byte << bpp) | index
+            used += bpp
+            if used == 8:
+                out.append(byte)
+                byte, used = 0, 0
+        if used:
+            out.append(byte << (8 - used))
+    return bytes(out)
+
+def compress_rgb565(pixels):
+    """
+    Encode RGB565 values in the QOI-style stream decoded by
+    lib/ili9341_image.c (the op table is documented in ili9341_image.h)
+    """
+    out = bytearray()
+    recent = [0] * 64
+    prev = 0
+    run = 0
+    
+    def flush_run():
+        nonlocal run
+        while run > 0:
+            if run >= 63:
+                n = min(run, 318)
+                out.extend((0xFF, n - 63))
+            else:
+                n = run
+                out.append(0xC0 | (n - 1))
+            run -= n
+    
+    for p in pixels:
+        if p == prev:
+            run += 1
+            continue
+        flush_run()
+        
+        r, g, b = p >> 11, (p >> 5) & 0x3F, p & 0x1F
+        pr, pg, pb = prev >> 11, (prev >> 5) & 0x3F, prev & 0x1F
+        dr, dg, db = r - pr, g - pg, b - pb
+        half = (dg + 32) // 2 - 16 if -32 <= dg <= 31 else 0
+        slot = (r * 3 + g * 5 + b * 7) % 64
+        
+        if recent[slot] == p:
+            out.append(slot)
+        elif -2 <= dr <= 1 and -2 <= dg <= 1 and -2 <= db <= 1:
+            out.append(0x40 | (dr + 2) << 4 | (dg + 2) << 2 | (db + 2))
+        elif -32 <= dg <= 31 and -8 <= dr - half <= 7 and -8 <= db - half <= 7:
+            out.extend((0x80 | (dg + 32), (dr - half + 8) << 4 | (db - half + 8)))
+        else:
+            out.extend((0xFE, p >> 8, p & 0xFF))
+        
+        recent[slot] = p
+        prev = p
+    flush_run()
+    return bytes(out)
+
+def pixel_values(rgb565, fmt):
+    """Array elements for one pixel in the given output format"""
+    if fmt == 'native':
+        return [f"0x{((rgb565 & 0xFF) << 8) | (rgb565 >> 8):04X}"]
+    if fmt == 'native-bytes':
+        return [f"0x{rgb565 >> 8:02X}", f"0x{rgb565 & 0xFF:02X}"]
+    return [f"0x{rgb565:04X}"]
+
+def write_header(output_file, var_name, width, height, rgb565, fmt, source, bpp=None):
+    """Write RGB565 pixels as a C header; returns the data size in bytes"""
+    palette = None
+    if fmt == 'compressed':
+        stream = compress_rgb565(rgb565)
+        values = [f"0x{byte:02X}" for byte in stream]
+        size = len(stream)
+    elif fmt == 'indexed':
+        palette, indices, bpp = palettize(rgb565, bpp)
+        packed = pack_indices(indices, width, bpp)
+        values = [f"0x{byte:02X}" for byte in packed]
+        size = len(packed) + len(palette) * 2
+    else:
+        values = []
+        for p in rgb565:
+            values.extend(pixel_values(p, fmt))
+        size = width * height * 2
+    per_line = 8 if FORMATS[fmt] == 'uint16_t' else 16
+    array_name = f"{var_name}_data" if fmt == 'compressed' else var_name
+    
+    with open(output_file, 'w') as f:
+        f.write(f"// Auto-generated from {source}\n")
+        f.write(f"// Image size: {width}x{height} pixels\n")
+        f.write(f"// Data size: {size} bytes\n")
+        if fmt == 'compressed':
+            f.write(f"// Compressed, draw with ili9341_draw_image()\n")
+        elif fmt == 'indexed':
+            f.write(f"// {len(palette)} colors at {bpp} bpp, draw with ili9341_draw_bitmap_indexed()\n")
+        elif fmt != 'rgb565':
+            f.write(f"// Panel byte order, draw with ili9341_draw_bitmap_be()\n")
+        f.write("\n")
+        f.write(f"#ifndef {var_name.upper()}_H\n")
+        f.write(f"#define {var_name.upper()}_H\n\n")
+        f.write(f"#include <stdint.h>\n")
+        if fmt == 'compressed':
+            f.write(f"#include \"ili9341_image.h\"\n")
+        f.write("\n")
+        f.write(f"#define {var_name.upper()}_WIDTH {width}\n")
+        f.write(f"#define {var_name.upper()}_HEIGHT {height}\n")
+        if fmt == 'indexed':
+            f.write(f"#define {var_name.upper()}_BPP {bpp}\n\n")
+            f.write(f"const uint16_t {var_name}_palette[{len(palette)}] = {{\n")
+            for i in range(0, len(palette), 8):
+                line = ", ".join(f"0x{color:04X}" for color in palette[i:i + 8])
+                f.write(f"    {line}{',' if i + 8 < len(palette) else ''}\n")
+            f.write("};\n")
+        f.write("\n")
+        f.write(f"const {FORMATS[fmt]} {array_name}[{len(values)}] = {{\n")
+        
+        f.write("    ")
+        for i, value in enumerate(values):
+            f.write(value)
+            if i + 1 < len(values):
+                f.write(", ")
+                
+                # Line break every few values for readability
+                if (i + 1) % per_line == 0:
+                    f.write("\n    ")
+        
+        f.write("\n};\n\n")
+        if fmt == 'compressed':
+            f.write(f"const ili9341_image_t {var_name} = {{\n")
+            f.write(f"    {width}, {height}, sizeof({array_name}), {array_name}\n")
+            f.write("};\n\n")
+        f.write(f"#endif // {var_name.upper()}_H\n")
+    
+    return size
+
+def convert_image(input_file, output_file, var_name, max_width=None, max_height=None, fmt='rgb565',
+                  bpp=None):
     """
     Convert image to C array in RGB565 format
     
@@ -25,6 +207,8 @@ def convert_image(input_file, output_file, var_name, max_width=None, max_height=
         var_name: Variable name for the array
         max_width: Maximum width (will scale if larger)
         max_height: Maximum height (will scale if larger)
+        fmt: Output format, a key of FORMATS
+        bpp: Bits per pixel for indexed output (default: fewest that fit)
     """
     try:
         # Open and convert image to RGB
@@ -46,45 +230,28 @@ def convert_image(input_file, output_file, var_name, max_width=None, max_height=
             if img.size != original_size:
                 print(f"Resized from {original_size} to {img.size}")
         
+        if fmt == 'indexed':
+            img = quantize(img, 1 << (bpp or 8))
+        
         width, height = img.size
         pixels = img.load()
         
-        # Write C header file
-        with open(output_file, 'w') as f:
-            f.write(f"// Auto-generated from {os.path.basename(input_file)}\n")
-            f.write(f"// Image size: {width}x{height} pixels\n")
-            f.write(f"// Data size: {width * height * 2} bytes\n\n")
-            f.write(f"#ifndef {var_name.upper()}_H\n")
-            f.write(f"#define {var_name.upper()}_H\n\n")
-            f.write(f"#include <stdint.h>\n\n")
-            f.write(f"#define {var_name.upper()}_WIDTH {width}\n")
-            f.write(f"#define {var_name.upper()}_HEIGHT {height}\n\n")
-            f.write(f"const uint16_t {var_name}[{width * height}] = {{\n")
-            
-            pixel_count = 0
-            for y in range(height):
-                f.write("    ")
-                for x in range(width):
-                    r, g, b = pixels[x, y]
-                    rgb565 = rgb888_to_rgb565(r, g, b)
-                    f.write(f"0x{rgb565:04X}")
-                    
-                    pixel_count += 1
-                    if pixel_count < width * height:
-                        f.write(", ")
-                    
-                    # Line break every 8 values for readability
-                    if pixel_count % 8 == 0 and pixel_count < width * height:
-                        f.write("\n    ")
-            
-            f.write("\n};\n\n")
-            f.write(f"#endif // {var_name.upper()}_H\n")
+        rgb565 = []
+        for y in range(height):
+            for x in range(width):
+                r, g, b = pixels[x, y]
+                rgb565.append(rgb888_to_rgb565(r, g, b))
+        
+        size = write_header(output_file, var_name, width, height, rgb565, fmt,
+                            os.path.basename(input_file), bpp)
         
         print(f"✓ Successfully converted {input_file}")
         print(f"  Output: {output_file}")
         print(f"  Image size: {width}x{height}")
         print(f"  Total pixels: {width * height}")
-        print(f"  Array size: {width * height * 2} bytes ({(width * height * 2) / 1024:.2f} KB)")
+        print(f"  Array size: {size} bytes ({size / 1024:.2f} KB)")
+        if fmt in ('compressed', 'indexed'):
+            print(f"  Compression: {100.0 * size / (width * height * 2):.1f}% of raw RGB565")
         
         return True
         
@@ -100,50 +267,82 @@ def print_usage():
     print("Image to RGB565 C Array Converter")
     print("=" * 50)
     print("\nUsage:")
-    print("  python image_converter.py <input> <output> <varname> [max_width] [max_height]")
+    print("  python image_converter.py [options] <input> <output> <varname> [max_width] [max_height]")
     print("\nArguments:")
     print("  input      - Input image file (PNG, JPG, BMP, etc.)")
     print("  output     - Output .h header file")
     print("  varname    - Variable name for the C array")
     print("  max_width  - Optional: Maximum width (will scale down if needed)")
     print("  max_height - Optional: Maximum height (will scale down if needed)")
+    print("\nOptions:")
+    print("  --native       - Byte-swapped uint16_t array (panel byte order on the Pico)")
+    print("  --native-bytes - uint8_t array in panel byte order")
+    print("                   Both are drawn with ili9341_draw_bitmap_be()")
+    print("  --compressed   - Compressed stream, drawn with ili9341_draw_image()")
+    print("  --indexed      - Palette plus packed indices, drawn with ili9341_draw_bitmap_indexed()")
+    print("  --bpp N        - Indexed depth (1, 2, 4 or 8); quantizes to 2^N colors")
     print("\nExamples:")
     print("  python image_converter.py logo.png logo.h company_logo")
     print("  python image_converter.py photo.jpg photo.h my_photo 100 100")
     print("  python image_converter.py icon.png icon.h icon_data 48 48")
+    print("  python image_converter.py --native splash.png splash.h splash 320 240")
+    print("  python image_converter.py --compressed background.png background.h background 320 240")
+    print("  python image_converter.py --indexed --bpp 4 icon.png icon.h icon 48 48")
     print("\nRecommended sizes:")
     print("  - Small icons: 32x32 or 48x48")
     print("  - Medium images: 64x64 or 100x100")
     print("  - Large images: 160x160 or 200x200")
-    print("  - Full screen: 240x320 (not recommended - 150KB)")
+    print("  - Full screen: 240x320 (150KB raw; use --compressed for UI backgrounds)")
 
 def main():
-    if len(sys.argv) < 4:
+    fmt = 'rgb565'
+    bpp = None
+    args = []
+    argv = iter(sys.argv[1:])
+    for arg in argv:
+        if arg == '--bpp':
+            try:
+                bpp = int(next(argv, ''))
+            except ValueError:
+                bpp = None
+            if bpp not in INDEXED_BPP:
+                print(f"Error: --bpp must be one of 1, 2, 4 or 8")
+                sys.exit(1)
+            fmt = 'indexed'
+        elif arg.startswith('--'):
+            if arg[2:] not in FORMATS or arg == '--rgb565':
+                print(f"Error: unknown option {arg}")
+                sys.exit(1)
+            fmt = arg[2:]
+        else:
+            args.append(arg)
+    
+    if len(args) < 3:
         print_usage()
         sys.exit(1)
     
-    input_file = sys.argv[1]
-    output_file = sys.argv[2]
-    var_name = sys.argv[3]
+    input_file = args[0]
+    output_file = args[1]
+    var_name = args[2]
     
     max_width = None
     max_height = None
     
-    if len(sys.argv) > 4:
+    if len(args) > 3:
         try:
-            max_width = int(sys.argv[4])
+            max_width = int(args[3])
         except ValueError:
             print(f"Error: max_width must be an integer")
             sys.exit(1)
     
-    if len(sys.argv) > 5:
+    if len(args) > 4:
         try:
-            max_height = int(sys.argv[5])
+            max_height = int(args[4])
         except ValueError:
             print(f"Error: max_height must be an integer")
             sys.exit(1)
     
-    success = convert_image(input_file, output_file, var_name, max_width, max_height)
+    success = convert_image(input_file, output_file, var_name, max_width, max_height, fmt, bpp)
     sys.exit(0 if success else 1)
 
 if __name__ == "__main__":